@@ -0,0 +1,126 @@
+#include "FramePacer.h"
+#ifdef _WIN32
+// Sem isso o Sleep do Windows tem resolucao de ~15.6 ms
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+// So usa funcoes da GLFW, entao nao precisa da glad; o include vem da pasta
+// dependencies de cada projeto
+#define GLFW_INCLUDE_NONE
+#include <glfw/include/GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FramePacer::VsyncMode FramePacer::parseVsyncMode(const std::string& text)
+{
+	if (text == "off")
+		return VSYNC_OFF;
+	if (text == "on")
+		return VSYNC_ON;
+	return VSYNC_ADAPTIVE;
+}
+
+FramePacer::FramePacer(GLFWwindow* window, double targetFps, VsyncMode vsync)
+{
+	m_window = window;
+	m_vsync = vsync;
+	if (vsync == VSYNC_ADAPTIVE && !glfwExtensionSupported("WGL_EXT_swap_control_tear") && !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+	{
+		m_vsync = VSYNC_ON;
+	}
+	glfwSwapInterval(m_vsync == VSYNC_OFF ? 0 : m_vsync == VSYNC_ON ? 1 : -1);
+	if (targetFps > 0.0)
+	{
+		m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+	}
+#ifdef _WIN32
+	timeBeginPeriod(1);
+#endif
+	m_start = Clock::now();
+	m_nextFrame = m_start + m_period;
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+	timeEndPeriod(1);
+#endif
+}
+
+// Dorme de 1 em 1 ms enquanto o tempo que falta for maior que a duracao tipica de
+// um sleep (media mais um desvio padrao) e gira no que sobra
+void FramePacer::waitUntil(Clock::time_point deadline)
+{
+	while (true)
+	{
+		double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+		double estimate = m_sleepMean + std::sqrt(m_sleepM2 / m_sleepCount);
+		if (remaining <= estimate)
+		{
+			break;
+		}
+		Clock::time_point start = Clock::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		double observed = std::chrono::duration<double>(Clock::now() - start).count();
+		m_sleepCount++;
+		double delta = observed - m_sleepMean;
+		m_sleepMean += delta / m_sleepCount;
+		m_sleepM2 += delta * (observed - m_sleepMean);
+	}
+	while (Clock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void FramePacer::present()
+{
+	if (m_period > Clock::duration::zero())
+	{
+		waitUntil(m_nextFrame);
+		// Se ficou mais de um frame para tras, recomeca a contagem em vez de
+		// apresentar varios frames seguidos para alcancar
+		m_nextFrame += m_period;
+		Clock::time_point now = Clock::now();
+		if (m_nextFrame < now)
+		{
+			m_nextFrame = now + m_period;
+		}
+	}
+	glfwSwapBuffers(m_window);
+
+	Clock::time_point now = Clock::now();
+	if (m_presented)
+	{
+		double interval = std::chrono::duration<double>(now - m_lastPresent).count();
+		m_intervalCount++;
+		double delta = interval - m_intervalMean;
+		m_intervalMean += delta / m_intervalCount;
+		m_intervalM2 += delta * (interval - m_intervalMean);
+		m_intervalMax = std::max(m_intervalMax, interval);
+	}
+	m_lastPresent = now;
+	m_presented = true;
+}
+
+double FramePacer::getTime() const
+{
+	return std::chrono::duration<double>(Clock::now() - m_start).count();
+}
+
+void FramePacer::printReport(std::ostream& out) const
+{
+	const char* vsyncNames[] = { "desligado", "ligado", "adaptativo" };
+	double jitter = m_intervalCount > 0 ? std::sqrt(m_intervalM2 / m_intervalCount) : 0.0;
+	out << "Apresentacao: " << m_intervalCount << " intervalos | medio: " << m_intervalMean * 1000.0
+		<< " ms | jitter (desvio padrao): " << jitter * 1000.0 << " ms | maior: " << m_intervalMax * 1000.0
+		<< " ms | vsync: " << vsyncNames[m_vsync];
+	if (m_period > Clock::duration::zero())
+	{
+		out << " | alvo: " << 1.0 / std::chrono::duration<double>(m_period).count() << " FPS";
+	}
+	out << std::endl;
+}
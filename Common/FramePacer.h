@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <ostream>
+
+struct GLFWwindow;
+
+// Ritmo de apresentacao dos frames. present() espera ate a hora do proximo frame
+// (quando ha um FPS alvo) e troca os buffers; a espera dorme enquanto falta mais
+// do que um sleep costuma atrasar e gira so no final, entao nao ocupa um nucleo
+// inteiro e ainda acerta o prazo. O vsync adaptativo (swap interval -1, quando o
+// driver tem EXT_swap_control_tear) sincroniza com a tela mas nao trava um frame
+// que atrasou. Os tempos usam o steady_clock em double, sem a perda de precisao de
+// um float de segundos depois de muito tempo ligado. Tambem mede o jitter, a
+// variacao do intervalo entre uma apresentacao e a proxima.
+class FramePacer
+{
+public:
+	enum VsyncMode { VSYNC_OFF, VSYNC_ON, VSYNC_ADAPTIVE };
+	// "off", "on" ou "adaptive"; qualquer outro texto vira adaptive
+	static VsyncMode parseVsyncMode(const std::string& text);
+	// Precisa do contexto da janela corrente, por causa do glfwSwapInterval
+	FramePacer(GLFWwindow* window, double targetFps = 0.0, VsyncMode vsync = VSYNC_ADAPTIVE);
+	~FramePacer();
+	void present();
+	// Segundos desde a criacao do FramePacer
+	double getTime() const;
+	void printReport(std::ostream& out) const;
+private:
+	typedef std::chrono::steady_clock Clock;
+	void waitUntil(Clock::time_point deadline);
+	GLFWwindow* m_window;
+	VsyncMode m_vsync;
+	Clock::duration m_period = Clock::duration::zero();
+	Clock::time_point m_start;
+	Clock::time_point m_nextFrame;
+	Clock::time_point m_lastPresent;
+	bool m_presented = false;
+	// Quanto um sleep de 1 ms realmente dura (media e variancia, metodo de Welford)
+	double m_sleepMean = 0.001;
+	double m_sleepM2 = 0.0;
+	long long m_sleepCount = 1;
+	// Intervalos entre apresentacoes, em segundos
+	long long m_intervalCount = 0;
+	double m_intervalMean = 0.0;
+	double m_intervalM2 = 0.0;
+	double m_intervalMax = 0.0;
+};
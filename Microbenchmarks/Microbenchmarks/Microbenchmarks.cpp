@@ -0,0 +1,258 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "../../Tarefa M2/Exercicio 3/Tarefa M2/Triangle.h"
+#include "../../Tarefa M3/Tarefa M3/Tarefa M3/QuadBoard.h"
+#include "../../Tarefa M5/Tarefa M5/Tarefa M5/ControllableCharacter.h"
+
+// Microbenchmarks de CPU das regras de jogo dos exercicios, sem janela nem
+// contexto OpenGL: geracao do tabuleiro, teste de clique e remocao por cor da
+// Tarefa M3, criacao de triangulos da Tarefa M2 e ControllableCharacter::update
+// (com updateAnimationFromVelocity) da Tarefa M5. As entradas sao sinteticas e
+// crescem de tamanho; para cada (kernel, tamanho) sai o tempo medio em ns/op e
+// as alocacoes de memoria por op, contadas pelo operator new abaixo.
+
+static long long g_allocationCount = 0;
+static long long g_allocationBytes = 0;
+
+void* operator new(std::size_t size)
+{
+	g_allocationCount++;
+	g_allocationBytes += size;
+	void* pointer = std::malloc(size ? size : 1);
+	if (!pointer)
+	{
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+typedef std::chrono::steady_clock Clock;
+
+// Evita que o compilador descarte o resultado dos kernels
+static volatile double g_sink = 0.0;
+
+static double maxSeconds = 0.5;
+static std::string filter;
+static bool csv = false;
+
+// Tempo minimo de um lote de ops entre duas leituras do relogio, para que o custo
+// do Clock::now() fique desprezivel mesmo nos kernels de poucos ns
+static const double MIN_BATCH_NS = 20000.0;
+
+// Mede operation(i) em lotes: prepare(count) monta fora da medida as entradas
+// 0..count-1 e o lote inteiro roda entre duas leituras do relogio. O tamanho do
+// lote dobra (na rodada de aquecimento) ate passar de MIN_BATCH_NS; depois os
+// lotes se repetem ate passar de maxSeconds. Tempo e alocacoes sao divididos
+// pelo numero de ops
+template <typename Prepare, typename Operation>
+static void measure(const std::string& name, int size, Prepare prepare, Operation operation)
+{
+	if (!filter.empty() && name.find(filter) == std::string::npos)
+	{
+		return;
+	}
+	auto runBatch = [&](int batch) {
+		prepare(batch);
+		Clock::time_point batchStart = Clock::now();
+		for (int i = 0; i < batch; i++)
+		{
+			operation(i);
+		}
+		return std::chrono::duration<double, std::nano>(Clock::now() - batchStart).count();
+	};
+	int batch = 1;
+	while (runBatch(batch) < MIN_BATCH_NS)
+	{
+		batch *= 2;
+	}
+
+	double totalNs = 0.0;
+	long long allocations = 0;
+	long long bytes = 0;
+	long long ops = 0;
+	Clock::time_point start = Clock::now();
+	do
+	{
+		prepare(batch);
+		long long countBefore = g_allocationCount;
+		long long bytesBefore = g_allocationBytes;
+		Clock::time_point batchStart = Clock::now();
+		for (int i = 0; i < batch; i++)
+		{
+			operation(i);
+		}
+		Clock::time_point batchEnd = Clock::now();
+		allocations += g_allocationCount - countBefore;
+		bytes += g_allocationBytes - bytesBefore;
+		totalNs += std::chrono::duration<double, std::nano>(batchEnd - batchStart).count();
+		ops += batch;
+	} while (std::chrono::duration<double>(Clock::now() - start).count() < maxSeconds);
+
+	if (csv)
+	{
+		std::cout << name << "," << size << "," << ops << "," << totalNs / ops << ","
+			<< (double)allocations / ops << "," << (double)bytes / ops << std::endl;
+	}
+	else
+	{
+		std::cout << std::left << std::setw(28) << name << std::right << std::setw(10) << size
+			<< std::setw(10) << ops << std::fixed << std::setprecision(1) << std::setw(16) << totalNs / ops
+			<< std::setprecision(2) << std::setw(14) << (double)allocations / ops
+			<< std::setprecision(0) << std::setw(14) << (double)bytes / ops << std::endl;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	// --seconds limita o tempo de cada medida, --filter roda so os kernels cujo
+	// nome contem o texto e --csv troca a tabela por CSV
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--seconds" && i + 1 < argc)
+			maxSeconds = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--filter" && i + 1 < argc)
+			filter = argv[++i];
+		if (std::string(argv[i]) == "--csv")
+			csv = true;
+	}
+	if (csv)
+	{
+		std::cout << "kernel,size,ops,ns_per_op,allocs_per_op,bytes_per_op" << std::endl;
+	}
+	else
+	{
+		std::cout << std::left << std::setw(28) << "kernel" << std::right << std::setw(10) << "size"
+			<< std::setw(10) << "ops" << std::setw(16) << "ns/op" << std::setw(14) << "allocs/op"
+			<< std::setw(14) << "bytes/op" << std::endl;
+	}
+
+	std::mt19937 gen(12345);
+
+	// Tarefa M3: tabuleiros de 20x20 (o do jogo) ate 2048x2048; size e o lado. O
+	// tabuleiro e gerado uma vez por tamanho, fora das medidas, e cada kernel usa o seu
+	const int boardSides[] = { 20, 64, 256, 1024, 2048 };
+	for (int side : boardSides)
+	{
+		std::vector<Quad> quads;
+		generateQuads(quads, side, side, gen);
+
+		// Cada op do lote gera num vetor vazio proprio
+		std::vector<std::vector<Quad>> generated;
+		measure("m3_generate_quads", side, [&](int count) {
+			generated.resize(count);
+			for (std::vector<Quad>& board : generated)
+			{
+				board.clear();
+				board.shrink_to_fit();
+			}
+		}, [&](int i) {
+			generateQuads(generated[i], side, side, gen);
+			g_sink = g_sink + generated[i].size();
+		});
+		generated.clear();
+		generated.shrink_to_fit();
+
+		// Cliques em pontos aleatorios do tabuleiro (o teste percorre todos os quads);
+		// o teste nao altera o tabuleiro, entao a copia e feita uma vez so
+		std::vector<Quad> clickBoard = quads;
+		std::uniform_real_distribution<> dist_x(0.0, side * 40.0);
+		std::uniform_real_distribution<> dist_y(0.0, side * 30.0);
+		std::vector<double> xs, ys;
+		measure("m3_find_quad", side, [&](int count) {
+			xs.resize(count);
+			ys.resize(count);
+			for (int i = 0; i < count; i++)
+			{
+				xs[i] = dist_x(gen);
+				ys[i] = dist_y(gen);
+			}
+		}, [&](int i) {
+			g_sink = g_sink + findQuadAt(clickBoard, xs[i], ys[i]);
+		});
+		clickBoard.clear();
+		clickBoard.shrink_to_fit();
+
+		// Remocao com o limiar de cor do jogo a partir de uma celula aleatoria, sempre
+		// sobre uma copia nova do tabuleiro cheio. Cada erase move o resto do vetor,
+		// entao o custo cresce com o quadrado do lado; acima de 256x256 uma unica
+		// medida leva minutos
+		if (side <= 256)
+		{
+			std::vector<std::vector<Quad>> boards;
+			std::vector<int> indices;
+			std::uniform_int_distribution<> dist_index(0, (int)quads.size() - 1);
+			measure("m3_remove_similar", side, [&](int count) {
+				boards.resize(count);
+				indices.resize(count);
+				for (int i = 0; i < count; i++)
+				{
+					boards[i] = quads;
+					indices[i] = dist_index(gen);
+				}
+			}, [&](int i) {
+				g_sink = g_sink + removeSimilarQuads(boards[i], indices[i], 0.2f).size();
+			});
+		}
+	}
+
+	// Tarefa M2: triangulos criados num frame (como no --stress), guardados num vetor
+	// que e limpo a cada frame como o m_pending do TriangleStore (um vetor por op do lote)
+	const int triangleCounts[] = { 1, 100, 10000, 1000000 };
+	for (int count : triangleCounts)
+	{
+		std::vector<std::vector<Triangle>> pending;
+		std::uniform_real_distribution<> dist_x(0.0, 800.0);
+		std::uniform_real_distribution<> dist_y(0.0, 600.0);
+		measure("m2_spawn_triangles", count, [&](int batch) {
+			pending.resize(batch);
+			for (std::vector<Triangle>& frame : pending)
+			{
+				frame.clear();
+			}
+		}, [&](int i) {
+			for (int j = 0; j < count; j++)
+			{
+				pending[i].push_back(randomTriangle(glm::vec3(dist_x(gen), dist_y(gen), 0.0), gen));
+			}
+			g_sink = g_sink + pending[i].size();
+		});
+	}
+
+	// Tarefa M5: um passo de update em N personagens com velocidades aleatorias
+	// (parados, nas quatro direcoes e na diagonal), com spritesheet 8x4 como o jogo
+	const int characterCounts[] = { 1, 100, 10000, 1000000 };
+	for (int count : characterCounts)
+	{
+		std::vector<ControllableCharacter> characters(count);
+		std::uniform_int_distribution<> dist_direction(-1, 1);
+		for (ControllableCharacter& character : characters)
+		{
+			character.setSpriteSheet(8, 4);
+			character.setVelocity(glm::vec3(dist_direction(gen), dist_direction(gen), 0.0f));
+		}
+		measure("m5_character_update", count, [](int) {}, [&](int) {
+			for (ControllableCharacter& character : characters)
+			{
+				character.update(1.0f / 60.0f);
+			}
+			g_sink = g_sink + characters[0].getFrameIndex();
+		});
+	}
+	return 0;
+}
@@ -8,7 +8,9 @@
 #include "dependencies/glm/gtc/type_ptr.hpp"
 #include <vector>
 #include <random>
-
+#include <cstdlib>
+#include "TriangleStore.h"
+#include "../../../Common/FramePacer.h"
 
 #include <cmath>
 // Prottipo da funo de callback de teclado
@@ -16,10 +18,13 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 
+void window_refresh_callback(GLFWwindow* window);
+
+void window_iconify_callback(GLFWwindow* window, int iconified);
+
 // Prottipos das funes
 int setupShader();
 int setupGeometry();
-GLuint createTriangle(float x0, float y0, float x1, float y1, float x2, float y2);
 
 // Dimenses da janela (pode ser alterado em tempo de execuo)
 const GLuint WIDTH = 800, HEIGHT = 600;
@@ -27,37 +32,73 @@ const GLuint WIDTH = 800, HEIGHT = 600;
 // Cdigo fonte do Vertex Shader (em GLSL): ainda hardcoded
 const GLchar* vertexShaderSource = "#version 400\n"
 "layout (location = 0) in vec3 position;\n"
+"layout (location = 1) in vec3 trianglePosition;\n"
+"layout (location = 2) in vec3 triangleDimensions;\n"
+"layout (location = 3) in vec3 triangleColor;\n"
 "uniform mat4 projection;\n"
-"uniform mat4 model;\n"
+"out vec4 inputColor;\n"
 "void main()\n"
 "{\n"
-"gl_Position = projection * model * vec4(position.x, position.y, position.z, 1.0);\n"
+"gl_Position = projection * vec4(trianglePosition + position * triangleDimensions, 1.0);\n"
+"inputColor = vec4(triangleColor, 1.0);\n"
 "}\0";
 
 //Cdigo fonte do Fragment Shader (em GLSL): ainda hardcoded
 const GLchar* fragmentShaderSource = "#version 400\n"
-"uniform vec4 inputColor;\n"
+"in vec4 inputColor;\n"
 "out vec4 color;\n"
 "void main()\n"
 "{\n"
 "color = inputColor;\n"
 "}\n\0";
 
-struct Triangle {
-	glm::vec3 position;
-	glm::vec3 dimensions;
-	glm::vec3 color;
+// Forma base do tringulo, escalada pelas dimenses de cada um
+const glm::vec3 triangleShape[3] = {
+	glm::vec3(-0.1, -0.1, 0.0),
+	glm::vec3(0.1, -0.1, 0.0),
+	glm::vec3(0.0, 0.1, 0.0)
 };
 
-std::vector<Triangle> triangles;
-
 std::random_device rd;
 std::mt19937 gen(rd());
 
+// Os tringulos ficam num buffer de instncias na GPU e s recebem acrscimos
+TriangleStore* triangleStore = nullptr;
+
+// Com --on-demand o loop dorme em glfwWaitEvents e s desenha quando a cena muda:
+// sceneDirty  ligado pelo clique e quando a janela precisa ser redesenhada
+// (exposta de novo, restaurada). Minimizada, a janela no  desenhada em nenhum modo
+bool sceneDirty = true;
+bool windowIconified = false;
+
 
 // Funo MAIN
-int main()
+int main(int argc, char** argv)
 {
+	// Com --stress [N] so criados N tringulos por frame (1000 por padro),
+	// para medir quantos tringulos por segundo o TriangleStore aguenta
+	int stressPerFrame = 0;
+	// --fps N limita a taxa de frames (0 = sem limite) e --vsync off|on|adaptive
+	// escolhe o vsync (adaptativo por padro)
+	double targetFps = 0.0;
+	FramePacer::VsyncMode vsync = FramePacer::VSYNC_ADAPTIVE;
+	bool onDemand = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--fps" && i + 1 < argc)
+			targetFps = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--vsync" && i + 1 < argc)
+			vsync = FramePacer::parseVsyncMode(argv[++i]);
+		if (std::string(argv[i]) == "--on-demand")
+			onDemand = true;
+		if (std::string(argv[i]) == "--stress")
+		{
+			stressPerFrame = 1000;
+			if (i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+				stressPerFrame = std::atoi(argv[++i]);
+		}
+	}
+
 	// Inicializao da GLFW
 	glfwInit();
 
@@ -68,6 +109,8 @@ int main()
 	// Fazendo o registro da funo de callback para a janela GLFW
 	glfwSetKeyCallback(window, key_callback);
 	glfwSetMouseButtonCallback(window, mouse_button_callback);
+	glfwSetWindowRefreshCallback(window, window_refresh_callback);
+	glfwSetWindowIconifyCallback(window, window_iconify_callback);
 
 	// GLAD: carrega todos os ponteiros d funes da OpenGL
 	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -87,36 +130,44 @@ int main()
 	glfwGetFramebufferSize(window, &width, &height);
 	glViewport(0, 0, width, height);
 
+	// Ritmo dos frames: espera o FPS alvo, vsync e medida do jitter entre apresentaes
+	FramePacer framePacer(window, targetFps, vsync);
+
 
 	// Compilando e buildando o programa de shader
 	GLuint shaderID = setupShader();
 
-	GLuint VAO = createTriangle(-0.1, -0.1, 0.1, -0.1, 0.0, 0.1);
+	triangleStore = new TriangleStore(triangleShape);
 	Triangle tri;
 	tri.position = glm::vec3(400.0, 300.0, 0.0);
 	tri.dimensions = glm::vec3(200.0, 200.0, 1.0);
 	tri.color = glm::vec3(1.0, 0.0, 0.0);
-	triangles.push_back(tri);
+	triangleStore->append(tri);
 
 	glUseProgram(shaderID);
 
-	// Enviando a cor desejada (vec4) para o fragment shader
-	// Utilizamos a variveis do tipo uniform em GLSL para armazenar esse tipo de info
-	// que no est nos buffers
-	GLint colorLoc = glGetUniformLocation(shaderID, "inputColor");
-
 	//Matriz de projeo paralela ortogrfica
 	glm::mat4 projection = glm::ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);
 	glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, value_ptr(projection));
 
-	glm::mat4 model;
-
+	std::uniform_real_distribution<> dist_x(0.0, WIDTH);
+	std::uniform_real_distribution<> dist_y(0.0, HEIGHT);
+	double statsStart = framePacer.getTime();
+	int statsFrames = 0;
+	int statsSpawned = 0;
 
 	// Loop da aplicao - "game loop"
 	while (!glfwWindowShouldClose(window))
 	{
-		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funes de callback correspondentes
+		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funes de callback correspondentes.
+		// Sem nada para desenhar, espera bloqueada pelo prximo evento em vez de girar
+		if (windowIconified || (onDemand && !sceneDirty && stressPerFrame == 0))
+		{
+			glfwWaitEvents();
+			continue;
+		}
 		glfwPollEvents();
+		sceneDirty = false;
 	
 		// Limpa o buffer de cor
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f); //cor de fundo
@@ -125,25 +176,41 @@ int main()
 		glLineWidth(10);
 		glPointSize(20);
 
-		glBindVertexArray(VAO);
-
-		for (int i = 0; i < triangles.size(); i++)
+		if (stressPerFrame > 0)
 		{
-			model = glm::mat4(1); 
-			model = glm::translate(model, triangles[i].position);
-			model = glm::scale(model, triangles[i].dimensions);
-			glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-			glUniform4f(colorLoc, triangles[i].color.r, triangles[i].color.g, triangles[i].color.b, 1.0f);
-			glDrawArrays(GL_TRIANGLES, 0, 3);
+			for (int i = 0; i < stressPerFrame; i++)
+			{
+				triangleStore->append(randomTriangle(glm::vec3(dist_x(gen), dist_y(gen), 0.0), gen));
+			}
+			statsSpawned += stressPerFrame;
 		}
 
-		glBindVertexArray(0); //Desconectando o buffer de geometria
+		// S os tringulos novos so enviados; todos saem numa chamada de desenho s
+		triangleStore->draw();
+
+		if (stressPerFrame > 0)
+		{
+			statsFrames++;
+			double elapsed = framePacer.getTime() - statsStart;
+			if (elapsed >= 1.0)
+			{
+				std::cout << "Triangulos: " << triangleStore->getCount()
+					<< " | capacidade: " << triangleStore->getCapacity()
+					<< " | " << elapsed * 1000.0 / statsFrames << " ms/frame"
+					<< " | " << (int)(statsSpawned / elapsed) << " triangulos/s" << std::endl;
+				statsStart = framePacer.getTime();
+				statsFrames = 0;
+				statsSpawned = 0;
+			}
+		}
 
 		// Troca os buffers da tela
-		glfwSwapBuffers(window);
+		framePacer.present();
 	}
 	// Pede pra OpenGL desalocar os buffers
-	glDeleteVertexArrays(1, &VAO);
+	triangleStore->deleteBuffers();
+	delete triangleStore;
+	framePacer.printReport(std::cout);
 	// Finaliza a execuo da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
 	return 0;
@@ -253,42 +320,25 @@ int setupGeometry()
 	return VAO;
 }
 
-GLuint createTriangle(float x0, float y0, float x1, float y1, float x2, float y2) {
-	GLfloat vertices[] = {
-		x0, y0, 0.0f,  // Vrtice 0
-		x1, y1, 0.0f,  // Vrtice 1
-		x2, y2, 0.0f   // Vrtice 2
-	};
-
-	GLuint VBO, VAO;
-	glGenBuffers(1, &VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-	glEnableVertexAttribArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-	glBindVertexArray(0);
-
-	return VAO;
-}
-
-
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 {
 	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
 	{
+		sceneDirty = true;
 		double xpos, ypos;
 		glfwGetCursorPos(window, &xpos, &ypos);
-		Triangle tri;
-		tri.position = glm::vec3(xpos, HEIGHT - ypos, 0.0);
-		std::uniform_int_distribution<> dist_int(50, 300);
-		tri.dimensions = glm::vec3(dist_int(gen), dist_int(gen), 1.0);
-		std::uniform_real_distribution<> dist_real(0.0, 1.0);
-		tri.color = glm::vec3(dist_real(gen), dist_real(gen), 0.0);
-		triangles.push_back(tri);
+		triangleStore->append(randomTriangle(glm::vec3(xpos, HEIGHT - ypos, 0.0), gen));
 	}
 }
+
+// A janela foi exposta ou danificada e o contedo precisa ser desenhado de novo
+void window_refresh_callback(GLFWwindow* window)
+{
+	sceneDirty = true;
+}
+
+void window_iconify_callback(GLFWwindow* window, int iconified)
+{
+	windowIconified = iconified == GLFW_TRUE;
+	sceneDirty = true;
+}
@@ -0,0 +1,12 @@
+#include "Triangle.h"
+
+Triangle randomTriangle(glm::vec3 position, std::mt19937& gen)
+{
+	Triangle tri;
+	tri.position = position;
+	std::uniform_int_distribution<> dist_int(50, 300);
+	tri.dimensions = glm::vec3(dist_int(gen), dist_int(gen), 1.0);
+	std::uniform_real_distribution<> dist_real(0.0, 1.0);
+	tri.color = glm::vec3(dist_real(gen), dist_real(gen), 0.0);
+	return tri;
+}
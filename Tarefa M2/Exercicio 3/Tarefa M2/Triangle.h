@@ -0,0 +1,12 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+#include <random>
+
+struct Triangle {
+	glm::vec3 position;
+	glm::vec3 dimensions;
+	glm::vec3 color;
+};
+
+// Triangulo com tamanho e cor aleatorios na posicao indicada
+Triangle randomTriangle(glm::vec3 position, std::mt19937& gen);
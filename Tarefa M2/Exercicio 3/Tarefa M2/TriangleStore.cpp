@@ -0,0 +1,109 @@
+#include "TriangleStore.h"
+#include <cstddef>
+
+TriangleStore::TriangleStore(const glm::vec3 shape[3], int capacity)
+{
+	glGenVertexArrays(1, &VAO);
+	glBindVertexArray(VAO);
+	//forma base do triangulo, igual para todas as instancias
+	glGenBuffers(1, &shapeVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, shapeVBO);
+	glBufferData(GL_ARRAY_BUFFER, 3 * sizeof(glm::vec3), shape, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	//posicao, dimensoes e cor de cada triangulo
+	for (GLuint location = 1; location <= 3; location++)
+	{
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+	glBindVertexArray(0);
+	grow(capacity);
+}
+
+void TriangleStore::append(const Triangle& triangle)
+{
+	m_pending.push_back(triangle);
+}
+
+void TriangleStore::draw()
+{
+	flush();
+	if (m_count == 0)
+	{
+		return;
+	}
+	glBindVertexArray(VAO);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 3, m_count);
+	glBindVertexArray(0);
+}
+
+int TriangleStore::getCount() const
+{
+	return m_count + (int)m_pending.size();
+}
+
+int TriangleStore::getCapacity() const
+{
+	return m_capacity;
+}
+
+void TriangleStore::deleteBuffers()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &shapeVBO);
+	glDeleteBuffers(1, &instanceVBO);
+}
+
+// Envia os triangulos acrescentados desde o ultimo draw, num upload so
+void TriangleStore::flush()
+{
+	if (m_pending.empty())
+	{
+		return;
+	}
+	int count = m_count + (int)m_pending.size();
+	if (count > m_capacity)
+	{
+		int capacity = m_capacity;
+		while (capacity < count)
+		{
+			capacity *= 2;
+		}
+		grow(capacity);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glBufferSubData(GL_ARRAY_BUFFER, m_count * sizeof(Triangle), m_pending.size() * sizeof(Triangle), m_pending.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	m_count = count;
+	m_pending.clear();
+}
+
+// Troca o buffer de instancias por um maior, copiando o que ja estava na GPU
+void TriangleStore::grow(int capacity)
+{
+	GLuint buffer;
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, capacity * sizeof(Triangle), NULL, GL_DYNAMIC_DRAW);
+	if (instanceVBO != 0)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, instanceVBO);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, m_count * sizeof(Triangle));
+		glDeleteBuffers(1, &instanceVBO);
+	}
+	instanceVBO = buffer;
+	m_capacity = capacity;
+	setInstanceAttributes();
+}
+
+void TriangleStore::setInstanceAttributes()
+{
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Triangle), (GLvoid*)offsetof(Triangle, position));
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Triangle), (GLvoid*)offsetof(Triangle, dimensions));
+	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Triangle), (GLvoid*)offsetof(Triangle, color));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
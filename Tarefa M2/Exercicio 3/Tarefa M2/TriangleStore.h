@@ -0,0 +1,31 @@
+#pragma once
+#include "dependencies/glad/glad.h"
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include "Triangle.h"
+
+// Guarda os triangulos num buffer de instancias na GPU. Triangulos novos so sao
+// acrescentados no fim: append() junta os novos do frame e draw() envia so esse
+// trecho com um glBufferSubData antes de desenhar tudo com um glDrawArraysInstanced.
+// Quando o buffer enche, a capacidade dobra e o conteudo antigo e copiado na GPU
+// com glCopyBufferSubData, entao o custo por triangulo acrescentado e constante.
+class TriangleStore
+{
+public:
+	TriangleStore(const glm::vec3 shape[3], int capacity = 64);
+	void append(const Triangle& triangle);
+	void draw();
+	int getCount() const;
+	int getCapacity() const;
+	void deleteBuffers();
+private:
+	void flush();
+	void grow(int capacity);
+	void setInstanceAttributes();
+	std::vector<Triangle> m_pending;
+	int m_count = 0;
+	int m_capacity = 0;
+	GLuint VAO;
+	GLuint shapeVBO;
+	GLuint instanceVBO = 0;
+};
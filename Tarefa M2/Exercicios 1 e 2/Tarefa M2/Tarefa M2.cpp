@@ -6,7 +6,9 @@
 #include "dependencies/glm/glm.hpp"
 #include "dependencies/glm/gtc/matrix_transform.hpp"
 #include "dependencies/glm/gtc/type_ptr.hpp"
+#include "../../../Common/FramePacer.h"
 #include <vector>
+#include <cstdlib>
 
 using namespace std;
 using namespace glm;
@@ -42,8 +44,20 @@ const GLchar* fragmentShaderSource = "#version 400\n"
 "}\n\0";
 
 // Funo MAIN
-int main()
+int main(int argc, char** argv)
 {
+	// --fps N limita a taxa de frames (0 = sem limite) e --vsync off|on|adaptive
+	// escolhe o vsync (adaptativo por padro)
+	double targetFps = 0.0;
+	FramePacer::VsyncMode vsync = FramePacer::VSYNC_ADAPTIVE;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--fps" && i + 1 < argc)
+			targetFps = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--vsync" && i + 1 < argc)
+			vsync = FramePacer::parseVsyncMode(argv[++i]);
+	}
+
 	// Inicializao da GLFW
 	glfwInit();
 
@@ -72,6 +86,9 @@ int main()
 	glfwGetFramebufferSize(window, &width, &height);
 	glViewport(0, 0, width, height);
 
+	// Ritmo dos frames: espera o FPS alvo, vsync e medida do jitter entre apresentaes
+	FramePacer framePacer(window, targetFps, vsync);
+
 
 	// Compilando e buildando o programa de shader
 	GLuint shaderID = setupShader();
@@ -123,13 +140,14 @@ int main()
 		glBindVertexArray(0); //Desconectando o buffer de geometria
 
 		// Troca os buffers da tela
-		glfwSwapBuffers(window);
+		framePacer.present();
 	}
 	// Pede pra OpenGL desalocar os buffers
 	for (int i = 0; i < VAO.size(); i++)
 	{
 		glDeleteVertexArrays(1, &VAO[i]);
 	}
+	framePacer.printReport(std::cout);
 	// Finaliza a execuo da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
 	return 0;
@@ -0,0 +1,72 @@
+#include "BoardRenderer.h"
+#include "dependencies/glm/gtc/matrix_transform.hpp"
+#include "dependencies/glm/gtc/type_ptr.hpp"
+
+BoardRenderer::BoardRenderer(GLuint shaderID, int columns, int rows, glm::vec2 cellSize)
+{
+	m_columns = columns;
+	m_rows = rows;
+	m_cellSize = cellSize;
+	this->shaderID = shaderID;
+	m_modelLoc = glGetUniformLocation(shaderID, "model");
+
+	//quad unitario em triangle strip; o model estica ele ate o tamanho do tabuleiro
+	GLfloat vertices[] = {
+		0.0f, 0.0f, 0.0f,
+		1.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f,
+		1.0f, 1.0f, 0.0f
+	};
+	glGenVertexArrays(1, &VAO);
+	glBindVertexArray(VAO);
+	glGenBuffers(1, &VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	glBindVertexArray(0);
+
+	//um texel por celula; GL_NEAREST para cada celula ficar com uma cor so
+	glGenTextures(1, &m_textureID);
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, columns, rows, 0, GL_RGBA, GL_FLOAT, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+// Envia o tabuleiro inteiro; as cores vem linha a linha, a partir da linha de baixo
+void BoardRenderer::upload(const std::vector<glm::vec4>& colors)
+{
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_columns, m_rows, GL_RGBA, GL_FLOAT, colors.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void BoardRenderer::setCell(int column, int row, const glm::vec4& color)
+{
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, column, row, 1, 1, GL_RGBA, GL_FLOAT, &color[0]);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void BoardRenderer::draw()
+{
+	glUseProgram(shaderID);
+	glm::mat4 model = glm::scale(glm::mat4(1), glm::vec3(m_columns * m_cellSize.x, m_rows * m_cellSize.y, 1.0f));
+	glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+	glBindVertexArray(VAO);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void BoardRenderer::deleteBuffers()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteTextures(1, &m_textureID);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "dependencies/glad/glad.h"
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+
+// Desenha um tabuleiro de celulas coloridas com um unico quad. A cor de cada
+// celula fica num texel de uma textura (um texel por celula, filtro GL_NEAREST),
+// entao o custo por frame nao depende do numero de celulas. Mudar uma celula
+// atualiza so o texel dela com glTexSubImage2D.
+class BoardRenderer
+{
+public:
+	BoardRenderer(GLuint shaderID, int columns, int rows, glm::vec2 cellSize);
+	void upload(const std::vector<glm::vec4>& colors);
+	void setCell(int column, int row, const glm::vec4& color);
+	void draw();
+	void deleteBuffers();
+private:
+	int m_columns;
+	int m_rows;
+	glm::vec2 m_cellSize;
+	GLuint m_textureID;
+	GLuint VAO;
+	GLuint VBO;
+	GLuint shaderID;
+	GLint m_modelLoc;
+};
@@ -0,0 +1,53 @@
+#include "QuadBoard.h"
+
+void generateQuads(std::vector<Quad>& quads, int columns, int rows, std::mt19937& gen)
+{
+	std::uniform_real_distribution<> dist(0.0, 1.0);
+	for (int i = 0; i < columns; i++)
+	{
+		for (int j = 0; j < rows; j++)
+		{
+			Quad quadrado;
+			quadrado.bottom_left_position = glm::vec3(i * quadrado.width, j * quadrado.height, 0.0);
+			float r = dist(gen);
+			float g = dist(gen);
+			float b = dist(gen);
+			quadrado.color = glm::vec4(r, g, b, 1.0);
+			quads.push_back(quadrado);
+		}
+	}
+}
+
+int findQuadAt(const std::vector<Quad>& quads, double x, double y)
+{
+	for (size_t i = 0; i < quads.size(); i++)
+	{
+		if (x > quads[i].bottom_left_position.x && x < quads[i].bottom_left_position.x + quads[i].width
+			&& y > quads[i].bottom_left_position.y && y < quads[i].bottom_left_position.y + quads[i].height)
+		{
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+std::vector<glm::ivec2> removeSimilarQuads(std::vector<Quad>& quads, int index, float threshold)
+{
+	glm::vec4 temporary_color = quads[index].color;
+	std::vector<std::vector<Quad>::iterator> items_to_remove;
+	for (auto it = quads.begin(); it != quads.end(); it++)
+	{
+		if (glm::distance(temporary_color, (*it).color) <= threshold)
+		{
+			items_to_remove.push_back(it);
+		}
+	}
+	std::vector<glm::ivec2> removed;
+	removed.reserve(items_to_remove.size());
+	for (auto it = items_to_remove.rbegin(); it != items_to_remove.rend(); it++)
+	{
+		removed.push_back(glm::ivec2((*it)->bottom_left_position.x / (*it)->width, (*it)->bottom_left_position.y / (*it)->height));
+		quads.erase(*it);
+	}
+	return removed;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include <random>
+
+struct Quad {
+	glm::vec3 bottom_left_position;
+	unsigned int height = 30;		//com esses valores teremos 20 retangulos na vertical e 20 na horizontal
+	unsigned int width = 40;
+	glm::vec3 dimensions = glm::vec3(40.0, 30.0, 0.0);
+	glm::vec4 color;
+};
+
+// Regras do tabuleiro, sem nenhuma chamada OpenGL (tambem usadas pelos
+// microbenchmarks de CPU)
+
+// Acrescenta a quads um tabuleiro de columns x rows celulas com cores aleatorias
+void generateQuads(std::vector<Quad>& quads, int columns, int rows, std::mt19937& gen);
+
+// Indice do quad que contem o ponto (x, y), ou -1 se nenhum contem
+int findQuadAt(const std::vector<Quad>& quads, double x, double y);
+
+// Remove todos os quads com cor a ate threshold da cor de quads[index] e devolve
+// as celulas (coluna, linha) removidas, da ultima para a primeira
+std::vector<glm::ivec2> removeSimilarQuads(std::vector<Quad>& quads, int index, float threshold);
@@ -7,58 +7,87 @@
 #include "dependencies/glm/gtc/matrix_transform.hpp"
 #include "dependencies/glm/gtc/type_ptr.hpp"
 #include <vector>
+#include <cstdlib>
 #include <random>
 #include <cmath>
+#include "BoardRenderer.h"
+#include "QuadBoard.h"
+#include "../../../Common/FramePacer.h"
 // Prottipo da funo de callback de teclado
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 
+void window_refresh_callback(GLFWwindow* window);
+
+void window_iconify_callback(GLFWwindow* window, int iconified);
+
 // Prottipos das funes
 int setupShader();
-GLuint createTriangle(float x0, float y0, float x1, float y1, float x2, float y2);
-void generateQuads();
+void uploadBoard();
 
 // Dimenses da janela (pode ser alterado em tempo de execuo)
 const GLuint WIDTH = 800, HEIGHT = 600;
 
+// Nmero de clulas do tabuleiro
+const int BOARD_COLUMNS = 20, BOARD_ROWS = 20;
+
 // Cdigo fonte do Vertex Shader (em GLSL): ainda hardcoded
 const GLchar* vertexShaderSource = "#version 400\n"
 "layout (location = 0) in vec3 position;\n"
 "uniform mat4 projection;\n"
 "uniform mat4 model;\n"
+"out vec2 cellCoordinates;\n"
 "void main()\n"
 "{\n"
 "gl_Position = projection * model * vec4(position.x, position.y, position.z, 1.0);\n"
+"cellCoordinates = position.xy;\n"
 "}\0";
 
 //Cdigo fonte do Fragment Shader (em GLSL): ainda hardcoded
 const GLchar* fragmentShaderSource = "#version 400\n"
-"uniform vec4 inputColor;\n"
+"uniform sampler2D cellColors;\n"
+"in vec2 cellCoordinates;\n"
 "out vec4 color;\n"
 "void main()\n"
 "{\n"
-"color = inputColor;\n"
+"color = texture(cellColors, cellCoordinates);\n"
 "}\n\0";
 
-struct Quad {
-	glm::vec3 bottom_left_position;
-	GLuint height = 30;		//com esses valores teremos 20 retangulos na vertical e 20 na horizontal
-	GLuint width = 40;
-	glm::vec3 dimensions = glm::vec3(40.0, 30.0, 0.0);
-	glm::vec4 color;
-};
-
 std::vector<Quad> quads;
 
+// O tabuleiro inteiro  desenhado com um quad s; a cor de cada clula fica num texel
+BoardRenderer* board = nullptr;
+
 std::random_device rd;
 std::mt19937 gen(rd());
 
 int score = 0;
 
+// Com --on-demand o loop dorme em glfwWaitEvents e s desenha quando a cena muda:
+// sceneDirty  ligado pelo clique e quando a janela precisa ser redesenhada
+// (exposta de novo, restaurada). Minimizada, a janela no  desenhada em nenhum modo
+bool sceneDirty = true;
+bool windowIconified = false;
+
 // Funo MAIN
-int main()
+int main(int argc, char** argv)
 {
+	// --fps N limita a taxa de frames (0 = sem limite) e --vsync off|on|adaptive
+	// escolhe o vsync (adaptativo por padro)
+	double targetFps = 0.0;
+	FramePacer::VsyncMode vsync = FramePacer::VSYNC_ADAPTIVE;
+	bool onDemand = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--fps" && i + 1 < argc)
+			targetFps = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--vsync" && i + 1 < argc)
+			vsync = FramePacer::parseVsyncMode(argv[++i]);
+		if (std::string(argv[i]) == "--on-demand")
+			onDemand = true;
+	}
+
 	// Inicializao da GLFW
 	glfwInit();
 
@@ -69,6 +98,8 @@ int main()
 	// Fazendo o registro da funo de callback para a janela GLFW
 	glfwSetKeyCallback(window, key_callback);
 	glfwSetMouseButtonCallback(window, mouse_button_callback);
+	glfwSetWindowRefreshCallback(window, window_refresh_callback);
+	glfwSetWindowIconifyCallback(window, window_iconify_callback);
 
 	// GLAD: carrega todos os ponteiros d funes da OpenGL
 	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -87,34 +118,37 @@ int main()
 	glfwGetFramebufferSize(window, &width, &height);
 	glViewport(0, 0, width, height);
 
+	// Ritmo dos frames: espera o FPS alvo, vsync e medida do jitter entre apresentaes
+	FramePacer framePacer(window, targetFps, vsync);
+
 
 	// Compilando e buildando o programa de shader
 	GLuint shaderID = setupShader();
 
-	GLuint VAOup = createTriangle(0.0, 0.0, 0.0, 1.0, 1.0, 1.0);
-	GLuint VAOdown = createTriangle(0.0, 0.0, 1.0, 1.0, 1.0, 0.0);
+	board = new BoardRenderer(shaderID, BOARD_COLUMNS, BOARD_ROWS, glm::vec2(40.0, 30.0));
 
-	generateQuads();
+	generateQuads(quads, BOARD_COLUMNS, BOARD_ROWS, gen);
+	uploadBoard();
 
 	glUseProgram(shaderID);
 
-	// Enviando a cor desejada (vec4) para o fragment shader
-	// Utilizamos a variveis do tipo uniform em GLSL para armazenar esse tipo de info
-	// que no est nos buffers
-	GLint colorLoc = glGetUniformLocation(shaderID, "inputColor");
-
 	//Matriz de projeo paralela ortogrfica
 	glm::mat4 projection = glm::ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);
 	glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, value_ptr(projection));
 
-	glm::mat4 model;
-
 
 	// Loop da aplicao - "game loop"
 	while (!glfwWindowShouldClose(window))
 	{
-		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funes de callback correspondentes
+		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funes de callback correspondentes.
+		// Sem nada para desenhar, espera bloqueada pelo prximo evento em vez de girar
+		if (windowIconified || (onDemand && !sceneDirty))
+		{
+			glfwWaitEvents();
+			continue;
+		}
 		glfwPollEvents();
+		sceneDirty = false;
 
 		// Limpa o buffer de cor
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f); //cor de fundo
@@ -124,31 +158,15 @@ int main()
 		glPointSize(20);
 
 
-		for (int i = 0; i < quads.size(); i++)
-		{
-			glBindVertexArray(VAOup);
-			model = glm::mat4(1);
-			model = glm::translate(model, quads[i].bottom_left_position);
-			model = glm::scale(model, quads[i].dimensions);
-			glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-			glUniform4f(colorLoc, quads[i].color.r, quads[i].color.g, quads[i].color.b, quads[i].color.a);
-			glDrawArrays(GL_TRIANGLES, 0, 3);
-			glBindVertexArray(0);
-
-
-			glBindVertexArray(VAOdown);
-			glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-			glUniform4f(colorLoc, quads[i].color.r, quads[i].color.g, quads[i].color.b, quads[i].color.a);
-			glDrawArrays(GL_TRIANGLES, 0, 3);
-			glBindVertexArray(0);
-		}
+		board->draw();
 
 		// Troca os buffers da tela
-		glfwSwapBuffers(window);
+		framePacer.present();
 	}
 	// Pede pra OpenGL desalocar os buffers
-	glDeleteVertexArrays(1, &VAOup);
-	glDeleteVertexArrays(1, &VAOdown);
+	board->deleteBuffers();
+	delete board;
+	framePacer.printReport(std::cout);
 	// Finaliza a execuo da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
 	return 0;
@@ -206,37 +224,15 @@ int setupShader()
 	return shaderProgram;
 }
 
-GLuint createTriangle(float x0, float y0, float x1, float y1, float x2, float y2) {
-	GLfloat vertices[] = {
-		x0, y0, 0.0f,
-		x1, y1, 0.0f,
-		x2, y2, 0.0f
-	};
-
-	GLuint VBO, VAO;
-	glGenBuffers(1, &VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-	glEnableVertexAttribArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-	glBindVertexArray(0);
-
-	return VAO;
-}
-
-
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 {
 	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
 	{
+		sceneDirty = true;
 		if (quads.empty())
 		{
-			generateQuads();
+			generateQuads(quads, BOARD_COLUMNS, BOARD_ROWS, gen);
+			uploadBoard();
 			score = 0;
 		}
 		else
@@ -244,52 +240,48 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 			double xpos, ypos;
 			glfwGetCursorPos(window, &xpos, &ypos);
 			ypos = HEIGHT - ypos;
-			for (int i = 0; i < quads.size(); i++)
+			int clicked = findQuadAt(quads, xpos, ypos);	//identifica em qual retngulo ocorreu o clique do mouse
+			if (clicked >= 0)
 			{
-				if (xpos > quads[i].bottom_left_position.x && xpos < quads[i].bottom_left_position.x + quads[i].width	//identifica em qual retngulo 
-					&& ypos > quads[i].bottom_left_position.y && ypos < quads[i].bottom_left_position.y + quads[i].height) //ocorreu o clique do mouse
+				float color_threshold = 0.2;
+				std::vector<glm::ivec2> removed = removeSimilarQuads(quads, clicked, color_threshold);
+				score = score + glm::pow(removed.size() * 5, 2);
+				std::cout << "Score: " << score << std::endl;
+				for (const glm::ivec2& cell : removed)
+				{
+					// S o texel da clula removida  atualizado
+					board->setCell(cell.x, cell.y, glm::vec4(0.0, 0.0, 0.0, 1.0));
+				}
+				if (quads.empty())
 				{
-					glm::vec4 temporary_color = quads[i].color;
-					std::vector<std::vector<Quad>::iterator> items_to_remove;
-					float color_threshold = 0.2;
-					for (auto it = quads.begin(); it != quads.end(); it++)
-					{
-						if (glm::distance(temporary_color, (*it).color) <= color_threshold)
-						{
-							items_to_remove.push_back(it);
-						}
-					}
-					score = score + glm::pow(items_to_remove.size() * 5, 2);
-					std::cout << "Score: " << score << std::endl;
-					for (auto it = items_to_remove.rbegin(); it != items_to_remove.rend(); it++)
-					{
-						quads.erase(*it);
-					}
-					if (quads.empty())
-					{
-						std::cout << "clique na tela novamente para reiniciar" << std::endl;
-					}
-					return;
+					std::cout << "clique na tela novamente para reiniciar" << std::endl;
 				}
 			}
 		}
 	}
 }
 
-void generateQuads()
+// Envia as cores de todos os quads para a textura do tabuleiro
+void uploadBoard()
 {
-	std::uniform_real_distribution<> dist(0.0, 1.0);
-	for (int i = 0; i < 20; i++)
+	std::vector<glm::vec4> colors(BOARD_COLUMNS * BOARD_ROWS, glm::vec4(0.0, 0.0, 0.0, 1.0));
+	for (int i = 0; i < quads.size(); i++)
 	{
-		for (int j = 0; j < 20; j++)
-		{
-			Quad quadrado;
-			quadrado.bottom_left_position = glm::vec3(i * quadrado.width, j * quadrado.height, 0.0);
-			float r = dist(gen);
-			float g = dist(gen);
-			float b = dist(gen);
-			quadrado.color = glm::vec4(r, g, b, 1.0);
-			quads.push_back(quadrado);
-		}
+		int column = quads[i].bottom_left_position.x / quads[i].width;
+		int row = quads[i].bottom_left_position.y / quads[i].height;
+		colors[row * BOARD_COLUMNS + column] = quads[i].color;
 	}
+	board->upload(colors);
+}
+
+// A janela foi exposta ou danificada e o contedo precisa ser desenhado de novo
+void window_refresh_callback(GLFWwindow* window)
+{
+	sceneDirty = true;
+}
+
+void window_iconify_callback(GLFWwindow* window, int iconified)
+{
+	windowIconified = iconified == GLFW_TRUE;
+	sceneDirty = true;
 }
@@ -0,0 +1,290 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "dependencies/glad/glad.h"
+#include "dependencies/glfw/include/GLFW/glfw3.h"
+#include "dependencies/glm/glm.hpp"
+#include "ControllableCharacter.h"
+#include "SpriteBatch.h"
+#include "SpriteInstancer.h"
+#include "ShaderProgram.h"
+#include "FrameUniforms.h"
+#include "TextureAtlas.h"
+#include "RenderQueue.h"
+#include "Camera2D.h"
+#include "OffscreenTarget.h"
+#include "GLInstrumentation.h"
+#include "Shaders.h"
+#include "Scene.h"
+
+// Benchmark de escala da Tarefa M5: monta cenas com N sprites (as imagens do
+// atlas da Tarefa M5, um em cada IMAGE_COUNT com a spritesheet animada) e mede,
+// para cada estrategia de desenho, o tempo de frame (ate o glFinish), o tempo de
+// CPU para montar a fila e enviar os passes, o tempo da simulacao e as chamadas
+// OpenGL por frame. O resultado sai em CSV, uma linha por (estrategia, N).
+// Deve rodar na pasta da Tarefa M5, por causa dos caminhos dos assets.
+
+enum DrawStrategy { DRAW_PER_SPRITE, DRAW_BATCHED, DRAW_INSTANCED, STRATEGY_COUNT };
+const char* STRATEGY_NAMES[] = { "per_sprite", "batched", "instanced" };
+
+struct BenchmarkResult
+{
+	int frames = 0;
+	double frameMs = 0.0;
+	double maxFrameMs = 0.0;
+	double submitMs = 0.0;
+	double updateMs = 0.0;
+	GLCallCounts counts;
+};
+
+static std::vector<int> parseSizes(const std::string& text)
+{
+	std::vector<int> sizes;
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ','))
+	{
+		sizes.push_back(std::atoi(item.c_str()));
+	}
+	return sizes;
+}
+
+int main(int argc, char** argv)
+{
+	// --sizes lista os N separados por virgula; cada medida roda --frames frames ou
+	// ate --max-seconds segundos (o que vier antes), depois de --warmup frames
+	std::vector<int> sizes = { 1000, 10000, 100000, 1000000 };
+	int frameCount = 30;
+	int warmupFrames = 2;
+	double maxSeconds = 3.0;
+	const char* outputPath = nullptr;
+	bool headless = false;
+	bool useOSMesa = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--sizes" && i + 1 < argc)
+			sizes = parseSizes(argv[++i]);
+		if (std::string(argv[i]) == "--frames" && i + 1 < argc)
+			frameCount = std::atoi(argv[++i]);
+		if (std::string(argv[i]) == "--warmup" && i + 1 < argc)
+			warmupFrames = std::atoi(argv[++i]);
+		if (std::string(argv[i]) == "--max-seconds" && i + 1 < argc)
+			maxSeconds = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--output" && i + 1 < argc)
+			outputPath = argv[++i];
+		if (std::string(argv[i]) == "--headless")
+			headless = true;
+		if (std::string(argv[i]) == "--osmesa")
+		{
+			headless = true;
+			useOSMesa = true;
+		}
+	}
+
+	// A janela nunca aparece: tudo e desenhado no framebuffer offscreen
+	if (headless)
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	glfwInit();
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	if (headless)
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API, useOSMesa ? GLFW_OSMESA_CONTEXT_API : GLFW_EGL_CONTEXT_API);
+	GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Benchmark M5", nullptr, nullptr);
+	if (!window)
+	{
+		std::cerr << "Erro ao criar a janela" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		std::cerr << "Erro ao carregar a OpenGL" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	installGLCallCounters();
+	std::cerr << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+
+	OffscreenTarget offscreen(WIDTH, HEIGHT);
+	offscreen.bind();
+
+	ShaderProgram shader(setupShader(vertexShaderSource, fragmentShaderSource));
+	ShaderProgram batchShader(setupShader(batchVertexShaderSource, fragmentShaderSource));
+	ShaderProgram instancedShader(setupShader(instancedVertexShaderSource, fragmentShaderSource));
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDepthFunc(GL_LEQUAL);
+
+	FrameUniforms frameUniforms;
+	frameUniforms.attach(shader);
+	frameUniforms.attach(batchShader);
+	frameUniforms.attach(instancedShader);
+	const ShaderProgram* spritePrograms[] = { &shader, &batchShader, &instancedShader };
+	auto setAlphaCutoff = [&spritePrograms](float cutoff) {
+		for (const ShaderProgram* program : spritePrograms)
+		{
+			glUseProgram(program->getID());
+			glUniform1f(program->getUniformLocation("alphaCutoff"), cutoff);
+		}
+	};
+
+	SpriteBatch spriteBatch(batchShader.getID());
+	SpriteInstancer spriteInstancer(instancedShader.getID());
+	RenderQueue renderQueue;
+
+	TextureAtlas atlas;
+	for (int i = 0; i < IMAGE_COUNT; i++)
+	{
+		atlas.addImage(images[i].path, images[i].columns, images[i].rows);
+	}
+	atlas.build();
+
+	// A camera cobre o mundo inteiro, entao todos os sprites sao enviados todo frame
+	Camera2D camera(WORLD_SIZE.x, WORLD_SIZE.y);
+
+	// Os mesmos passes do renderFrame da Tarefa M5, sem o fundo
+	auto drawCommands = [&](DrawStrategy strategy, int first, int last) {
+		const std::vector<DrawCommand>& commands = renderQueue.getCommands();
+		if (strategy == DRAW_PER_SPRITE)
+		{
+			glUseProgram(shader.getID());
+			for (int i = first; i < last; i++) {
+				commands[i].sprite->Draw();
+			}
+		}
+		else if (strategy == DRAW_BATCHED)
+		{
+			spriteBatch.begin();
+			for (int i = first; i < last; i++) {
+				spriteBatch.submit(*commands[i].sprite);
+			}
+			spriteBatch.end();
+		}
+		else
+		{
+			spriteInstancer.begin(first >= renderQueue.getFirstTranslucent());
+			for (int i = first; i < last; i++) {
+				spriteInstancer.submit(*commands[i].sprite);
+			}
+			spriteInstancer.end();
+		}
+	};
+
+	std::ofstream file;
+	if (outputPath)
+		file.open(outputPath);
+	std::ostream& out = outputPath ? file : std::cout;
+	out << "strategy,sprites,frames,frame_ms,max_frame_ms,submit_ms,update_ms,draw_calls,program_binds,vertex_array_binds,buffer_binds,texture_binds,uniform_uploads,upload_bytes" << std::endl;
+
+	for (int size : sizes)
+	{
+		// A cena da Tarefa M5 com N - 6 inimigos espalhados; as imagens se alternam e os
+		// sprites da spritesheet andam, para a animacao rodar a cada frame
+		std::vector<SceneSprite> scene = buildScene(std::max(0, size - 6));
+		std::vector<Sprite*> sprites;
+		sprites.reserve(scene.size());
+		for (int i = 0; i < (int)scene.size(); i++)
+		{
+			SceneSprite& item = scene[i];
+			if (i > PLAYER)
+				item.image = i % IMAGE_COUNT;
+			bool animated = images[item.image].columns > 1;
+			Sprite* sprite = animated ? new ControllableCharacter(atlas.getRegion(item.image), shader) : new Sprite(atlas.getRegion(item.image), shader);
+			sprite->setScale(item.scale);
+			sprite->setSpriteSheet(images[item.image].columns, images[item.image].rows);
+			sprite->setRenderLayer(item.renderLayer);
+			glm::vec3 translate = item.translate;
+			translate.z = item.renderLayer * 0.1f + (float)i / scene.size() * 0.09f;
+			sprite->setTranslate(translate);
+			if (animated)
+				sprite->setVelocity(glm::vec3(i % 2 ? 1.0f : -1.0f, 0.0f, 0.0f));
+			sprites.push_back(sprite);
+		}
+
+		for (int strategy = 0; strategy < STRATEGY_COUNT; strategy++)
+		{
+			std::cerr << "Medindo " << STRATEGY_NAMES[strategy] << " com " << sprites.size() << " sprites" << std::endl;
+			BenchmarkResult result;
+			auto measureStart = std::chrono::steady_clock::now();
+			for (int frame = 0; frame < warmupFrames + frameCount; frame++)
+			{
+				takeGLCallCounts();
+				auto frameStart = std::chrono::steady_clock::now();
+				for (Sprite* sprite : sprites) {
+					sprite->update(1.0f / 60.0f);
+				}
+				auto updateEnd = std::chrono::steady_clock::now();
+
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+				frameUniforms.update(camera.getProjection(), frame / 60.0f);
+				renderQueue.clear();
+				for (Sprite* sprite : sprites) {
+					renderQueue.push(sprite);
+				}
+				renderQueue.sort();
+				int firstTranslucent = renderQueue.getFirstTranslucent();
+				glEnable(GL_DEPTH_TEST);
+				glDepthMask(GL_TRUE);
+				glDisable(GL_BLEND);
+				setAlphaCutoff(0.5f);
+				drawCommands((DrawStrategy)strategy, 0, firstTranslucent);
+				glDepthMask(GL_FALSE);
+				glEnable(GL_BLEND);
+				setAlphaCutoff(0.0f);
+				drawCommands((DrawStrategy)strategy, firstTranslucent, (int)renderQueue.getCommands().size());
+				glDepthMask(GL_TRUE);
+				glDisable(GL_DEPTH_TEST);
+				auto submitEnd = std::chrono::steady_clock::now();
+
+				// Espera a GPU, para o tempo de frame incluir o desenho e nao so o envio
+				glFinish();
+				auto frameEnd = std::chrono::steady_clock::now();
+				GLCallCounts counts = takeGLCallCounts();
+				if (frame < warmupFrames)
+				{
+					measureStart = frameEnd;
+					continue;
+				}
+
+				double frameMs = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+				result.frames++;
+				result.frameMs += frameMs;
+				result.maxFrameMs = std::max(result.maxFrameMs, frameMs);
+				result.submitMs += std::chrono::duration<double, std::milli>(submitEnd - updateEnd).count();
+				result.updateMs += std::chrono::duration<double, std::milli>(updateEnd - frameStart).count();
+				result.counts = counts;
+				if (std::chrono::duration<double>(frameEnd - measureStart).count() >= maxSeconds)
+					break;
+			}
+
+			// Tempos em media por frame; as chamadas sao as do ultimo frame (iguais em todos)
+			out << STRATEGY_NAMES[strategy] << "," << sprites.size() << "," << result.frames << ","
+				<< result.frameMs / result.frames << "," << result.maxFrameMs << ","
+				<< result.submitMs / result.frames << "," << result.updateMs / result.frames << ","
+				<< result.counts.drawCalls << "," << result.counts.programBinds << ","
+				<< result.counts.vertexArrayBinds << "," << result.counts.bufferBinds << ","
+				<< result.counts.textureBinds << "," << result.counts.uniformUploads << ","
+				<< result.counts.bufferUploadBytes << std::endl;
+		}
+
+		for (Sprite* sprite : sprites)
+		{
+			sprite->deleteVertexArray();
+			delete sprite;
+		}
+	}
+
+	spriteBatch.deleteBuffers();
+	spriteInstancer.deleteBuffers();
+	frameUniforms.deleteBuffer();
+	atlas.deleteTextures();
+	offscreen.deleteBuffers();
+	shader.deleteProgram();
+	batchShader.deleteProgram();
+	instancedShader.deleteProgram();
+	glfwTerminate();
+	return 0;
+}
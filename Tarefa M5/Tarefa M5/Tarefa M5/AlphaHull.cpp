@@ -0,0 +1,169 @@
+#include "AlphaHull.h"
+#include <algorithm>
+#include <cmath>
+
+static float cross(const glm::vec2& a, const glm::vec2& b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+static float polygonArea(const std::vector<glm::vec2>& polygon)
+{
+	float area = 0.0f;
+	for (int i = 0; i < (int)polygon.size(); i++)
+	{
+		area += cross(polygon[i], polygon[(i + 1) % polygon.size()]);
+	}
+	return area * 0.5f;
+}
+
+// Fecho convexo pelo algoritmo monotone chain, em sentido anti-horario
+static std::vector<glm::vec2> convexHull(std::vector<glm::vec2> points)
+{
+	std::sort(points.begin(), points.end(), [](const glm::vec2& a, const glm::vec2& b) {
+		return a.x < b.x || (a.x == b.x && a.y < b.y);
+	});
+	points.erase(std::unique(points.begin(), points.end()), points.end());
+	if (points.size() < 3)
+	{
+		return points;
+	}
+	std::vector<glm::vec2> hull(points.size() * 2);
+	int count = 0;
+	for (int i = 0; i < (int)points.size(); i++)
+	{
+		while (count >= 2 && cross(hull[count - 1] - hull[count - 2], points[i] - hull[count - 2]) <= 0.0f)
+		{
+			count--;
+		}
+		hull[count++] = points[i];
+	}
+	for (int i = (int)points.size() - 2, lower = count + 1; i >= 0; i--)
+	{
+		while (count >= lower && cross(hull[count - 1] - hull[count - 2], points[i] - hull[count - 2]) <= 0.0f)
+		{
+			count--;
+		}
+		hull[count++] = points[i];
+	}
+	hull.resize(count - 1);
+	return hull;
+}
+
+// Tira um vertice por vez: a aresta b-c que acrescenta menos area e trocada pelo
+// encontro das arestas vizinhas (a-b e d-c prolongadas), que fica do lado de fora
+static void reduceHull(std::vector<glm::vec2>& hull, int maxVertices, const glm::vec2& cellSize)
+{
+	while ((int)hull.size() > maxVertices)
+	{
+		int n = (int)hull.size();
+		int bestEdge = -1;
+		float bestArea = 0.0f;
+		glm::vec2 bestPoint;
+		for (int i = 0; i < n; i++)
+		{
+			const glm::vec2& a = hull[(i + n - 1) % n];
+			const glm::vec2& b = hull[i];
+			const glm::vec2& c = hull[(i + 1) % n];
+			const glm::vec2& d = hull[(i + 2) % n];
+			glm::vec2 u = b - a;
+			glm::vec2 v = c - d;
+			float denominator = cross(u, v);
+			if (std::abs(denominator) < 1e-6f)
+			{
+				continue;
+			}
+			float t = cross(c - b, v) / denominator;
+			float s = cross(c - b, u) / denominator;
+			if (t < 0.0f || s < 0.0f)
+			{
+				continue;
+			}
+			glm::vec2 point = b + t * u;
+			//o vertice novo nao pode sair do quadro da spritesheet
+			if (point.x < -1e-3f || point.y < -1e-3f || point.x > cellSize.x + 1e-3f || point.y > cellSize.y + 1e-3f)
+			{
+				continue;
+			}
+			float area = std::abs(cross(point - b, c - b)) * 0.5f;
+			if (bestEdge < 0 || area < bestArea)
+			{
+				bestEdge = i;
+				bestArea = area;
+				bestPoint = point;
+			}
+		}
+		if (bestEdge < 0)
+		{
+			return;
+		}
+		hull[bestEdge] = glm::clamp(bestPoint, glm::vec2(0.0f), cellSize);
+		hull.erase(hull.begin() + (bestEdge + 1) % n);
+	}
+}
+
+std::vector<glm::vec2> computeAlphaHull(const unsigned char* rgba, int width, int height, int columns, int rows, int maxVertices, float padding)
+{
+	int cellWidth = width / columns;
+	int cellHeight = height / rows;
+	if (cellWidth <= 0 || cellHeight <= 0)
+	{
+		return {};
+	}
+	//menor e maior x visivel de cada linha do quadro, somando todos os quadros
+	std::vector<int> minX(cellHeight, cellWidth);
+	std::vector<int> maxX(cellHeight, -1);
+	for (int row = 0; row < rows; row++)
+	{
+		for (int y = 0; y < cellHeight; y++)
+		{
+			const unsigned char* line = rgba + ((size_t)(row * cellHeight + y) * width) * 4;
+			for (int column = 0; column < columns; column++)
+			{
+				for (int x = 0; x < cellWidth; x++)
+				{
+					if (line[(column * cellWidth + x) * 4 + 3] > 0)
+					{
+						minX[y] = std::min(minX[y], x);
+						maxX[y] = std::max(maxX[y], x);
+					}
+				}
+			}
+		}
+	}
+
+	glm::vec2 cellSize((float)cellWidth, (float)cellHeight);
+	std::vector<glm::vec2> points;
+	for (int y = 0; y < cellHeight; y++)
+	{
+		if (maxX[y] < 0)
+		{
+			continue;
+		}
+		float left = minX[y] - padding;
+		float right = maxX[y] + 1.0f + padding;
+		float bottom = y - padding;
+		float top = y + 1.0f + padding;
+		points.push_back(glm::clamp(glm::vec2(left, bottom), glm::vec2(0.0f), cellSize));
+		points.push_back(glm::clamp(glm::vec2(left, top), glm::vec2(0.0f), cellSize));
+		points.push_back(glm::clamp(glm::vec2(right, bottom), glm::vec2(0.0f), cellSize));
+		points.push_back(glm::clamp(glm::vec2(right, top), glm::vec2(0.0f), cellSize));
+	}
+	std::vector<glm::vec2> hull = convexHull(points);
+	if (hull.size() < 3)
+	{
+		return {};
+	}
+	reduceHull(hull, maxVertices, cellSize);
+
+	//se quase nao sobra area transparente, o quad (4 vertices) sai mais barato
+	if (polygonArea(hull) > 0.85f * cellSize.x * cellSize.y)
+	{
+		return {};
+	}
+	for (glm::vec2& point : hull)
+	{
+		point /= cellSize;
+	}
+	return hull;
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+
+// Calcula um poligono convexo justo em volta dos pixels com alfa > 0 de uma imagem,
+// para o sprite nao rasterizar a parte transparente do quad. Em uma spritesheet
+// (columns x rows) o poligono cobre a uniao de todos os quadros, entao serve para
+// qualquer frameIndex. O contorno e conservador: cada pixel visivel ganha uma margem
+// de padding texels (para o filtro linear e os mipmaps) e o fecho convexo e reduzido
+// para no maximo maxVertices vertices so crescendo, nunca cortando pixels.
+// As coordenadas voltam em [0,1] dentro de um quadro, como as coordenadas de textura
+// do quad unitario. Volta vazio quando o poligono nao economiza o bastante.
+std::vector<glm::vec2> computeAlphaHull(const unsigned char* rgba, int width, int height, int columns = 1, int rows = 1, int maxVertices = 8, float padding = 2.0f);
@@ -0,0 +1,52 @@
+#include "Camera2D.h"
+#include "dependencies/glm/gtc/matrix_transform.hpp"
+#include <algorithm>
+
+Camera2D::Camera2D(float width, float height)
+{
+	m_size = glm::vec2(width, height);
+}
+
+void Camera2D::setPosition(glm::vec2 position)
+{
+	m_position = position;
+}
+
+// Centraliza a vista no alvo, respeitando os limites do mundo
+void Camera2D::follow(glm::vec2 target)
+{
+	m_position = target - m_size * 0.5f;
+	if (m_hasWorldBounds)
+	{
+		m_position.x = std::max(m_worldBounds.x, std::min(m_position.x, m_worldBounds.z - m_size.x));
+		m_position.y = std::max(m_worldBounds.y, std::min(m_position.y, m_worldBounds.w - m_size.y));
+	}
+}
+
+// Limites do mundo como (minX, minY, maxX, maxY)
+void Camera2D::setWorldBounds(glm::vec4 bounds)
+{
+	m_worldBounds = bounds;
+	m_hasWorldBounds = true;
+}
+
+glm::vec2 Camera2D::getPosition() const
+{
+	return m_position;
+}
+
+glm::vec2 Camera2D::getSize() const
+{
+	return m_size;
+}
+
+glm::mat4 Camera2D::getProjection() const
+{
+	return glm::ortho(m_position.x, m_position.x + m_size.x, m_position.y, m_position.y + m_size.y, -1.0f, 1.0f);
+}
+
+// Retangulo visivel como (minX, minY, maxX, maxY)
+glm::vec4 Camera2D::getViewBounds() const
+{
+	return glm::vec4(m_position, m_position + m_size);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+
+// Camera 2D com projecao ortografica. A posicao e o canto inferior esquerdo da
+// vista, em coordenadas de mundo. Com limites de mundo definidos, follow() nao
+// deixa a vista sair deles.
+class Camera2D
+{
+public:
+	Camera2D(float width, float height);
+	void setPosition(glm::vec2 position);
+	void follow(glm::vec2 target);
+	void setWorldBounds(glm::vec4 bounds);
+	glm::vec2 getPosition() const;
+	glm::vec2 getSize() const;
+	glm::mat4 getProjection() const;
+	glm::vec4 getViewBounds() const;
+private:
+	glm::vec2 m_position = glm::vec2(0.0f);
+	glm::vec2 m_size;
+	glm::vec4 m_worldBounds = glm::vec4(0.0f);
+	bool m_hasWorldBounds = false;
+};
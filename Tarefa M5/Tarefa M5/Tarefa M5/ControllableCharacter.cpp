@@ -2,7 +2,7 @@
 
 void ControllableCharacter::update(float deltaTime)
 {
-	m_translate += m_velocity;
+	m_translate += m_velocity * SPEED * deltaTime;
 	m_animTimer += deltaTime;
 	if(updateAnimationFromVelocity())
 	{ 
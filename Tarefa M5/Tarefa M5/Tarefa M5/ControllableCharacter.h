@@ -3,7 +3,19 @@
 class ControllableCharacter : public Sprite
 {
 public:
-	ControllableCharacter(const char* path, GLuint shaderId) : Sprite(path, shaderId) 
+	// Pixels por segundo para cada unidade de velocidade (as teclas somam 1): o
+	// mesmo pixel por frame a 60 FPS de antes, agora independente do FPS
+	static constexpr float SPEED = 60.0f;
+	ControllableCharacter(const char* path, const ShaderProgram& shader) : Sprite(path, shader) 
+	{
+		m_velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+	}
+	ControllableCharacter(const AtlasRegion& region, const ShaderProgram& shader) : Sprite(region, shader)
+	{
+		m_velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+	}
+	// Sem recursos de OpenGL, para os microbenchmarks de CPU
+	ControllableCharacter()
 	{
 		m_velocity = glm::vec3(0.0f, 0.0f, 0.0f);
 	}
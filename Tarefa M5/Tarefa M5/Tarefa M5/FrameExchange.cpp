@@ -0,0 +1,47 @@
+#include "FrameExchange.h"
+
+// Snapshot livre para a simulacao escrever (espera a renderizacao soltar ele)
+FrameSnapshot& FrameExchange::beginWrite()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_changed.wait(lock, [this] { return m_readingIndex != m_writeIndex || m_closed; });
+	return m_snapshots[m_writeIndex];
+}
+
+void FrameExchange::publish()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_changed.wait(lock, [this] { return m_readyIndex < 0 || m_closed; });
+	m_readyIndex = m_writeIndex;
+	m_writeIndex = 1 - m_writeIndex;
+	m_changed.notify_all();
+}
+
+// Proximo frame a desenhar, ou nullptr quando a troca foi fechada e nao sobrou frame
+FrameSnapshot* FrameExchange::acquire()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_changed.wait(lock, [this] { return m_readyIndex >= 0 || m_closed; });
+	if (m_readyIndex < 0)
+	{
+		return nullptr;
+	}
+	m_readingIndex = m_readyIndex;
+	m_readyIndex = -1;
+	m_changed.notify_all();
+	return &m_snapshots[m_readingIndex];
+}
+
+void FrameExchange::release()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_readingIndex = -1;
+	m_changed.notify_all();
+}
+
+void FrameExchange::close()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_closed = true;
+	m_changed.notify_all();
+}
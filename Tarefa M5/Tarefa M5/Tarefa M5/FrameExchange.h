@@ -0,0 +1,40 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "Camera2D.h"
+#include "Sprite.h"
+
+// Tudo que a thread de renderizacao precisa para desenhar um frame. Os sprites sao
+// copias dos sprites visiveis, entao a simulacao pode continuar mexendo nos originais.
+struct FrameSnapshot
+{
+	Camera2D camera = Camera2D(0.0f, 0.0f);
+	float time = 0.0f;
+	int drawMode = 0;
+	// Tempo de CPU da simulacao deste frame, para o GpuProfiler
+	double simulationMs = 0.0;
+	std::vector<Sprite> sprites;
+};
+
+// Troca de frames entre a simulacao e a renderizacao com dois FrameSnapshots:
+// enquanto a renderizacao desenha um, a simulacao preenche o outro. publish() espera
+// o frame anterior ser pego, entao a simulacao fica no maximo um frame a frente.
+// Depois de close(), acquire() ainda entrega o ultimo frame publicado e depois nullptr.
+class FrameExchange
+{
+public:
+	FrameSnapshot& beginWrite();
+	void publish();
+	FrameSnapshot* acquire();
+	void release();
+	void close();
+private:
+	FrameSnapshot m_snapshots[2];
+	int m_writeIndex = 0;
+	int m_readyIndex = -1;
+	int m_readingIndex = -1;
+	bool m_closed = false;
+	std::mutex m_mutex;
+	std::condition_variable m_changed;
+};
@@ -0,0 +1,152 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+
+FrameStats::FrameStats(double hitchMs)
+{
+	m_hitchMs = hitchMs;
+	m_buckets.assign(BUCKET_COUNT, 0);
+}
+
+// Chamado so pela thread que apresenta os frames. Com o anel cheio o tempo e
+// descartado (e contado), a thread de apresentacao nunca espera
+void FrameStats::record(double frameMs)
+{
+	uint32_t head = m_head.load(std::memory_order_relaxed);
+	if (head - m_tail.load(std::memory_order_acquire) == RING_SIZE)
+	{
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	m_ring[head % RING_SIZE] = frameMs;
+	m_head.store(head + 1, std::memory_order_release);
+}
+
+// Chamado so pela thread que le as estatisticas
+void FrameStats::collect()
+{
+	uint32_t tail = m_tail.load(std::memory_order_relaxed);
+	uint32_t head = m_head.load(std::memory_order_acquire);
+	for (; tail != head; tail++)
+	{
+		double frameMs = m_ring[tail % RING_SIZE];
+		m_buckets[bucketIndex((uint64_t)std::max(0.0, frameMs * 1000.0))]++;
+		m_count++;
+		m_sumMs += frameMs;
+		m_maxMs = std::max(m_maxMs, frameMs);
+		if (frameMs > m_hitchMs)
+		{
+			m_hitches++;
+		}
+	}
+	m_tail.store(tail, std::memory_order_release);
+}
+
+// Zera o histograma (por exemplo, depois do aquecimento do benchmark)
+void FrameStats::reset()
+{
+	collect();
+	std::fill(m_buckets.begin(), m_buckets.end(), 0);
+	m_count = 0;
+	m_hitches = 0;
+	m_sumMs = 0.0;
+	m_maxMs = 0.0;
+	m_dropped = 0;
+}
+
+// percentile em [0,100], em ms
+double FrameStats::getPercentile(double percentile) const
+{
+	if (m_count == 0)
+	{
+		return 0.0;
+	}
+	int64_t target = (int64_t)std::ceil(percentile / 100.0 * m_count);
+	target = std::max<int64_t>(target, 1);
+	int64_t seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; i++)
+	{
+		seen += m_buckets[i];
+		if (seen >= target)
+		{
+			return std::min(bucketValue(i) / 1000.0, m_maxMs);
+		}
+	}
+	return m_maxMs;
+}
+
+double FrameStats::getMaxMs() const
+{
+	return m_maxMs;
+}
+
+double FrameStats::getAverageFps() const
+{
+	return m_sumMs > 0.0 ? m_count * 1000.0 / m_sumMs : 0.0;
+}
+
+int64_t FrameStats::getFrameCount() const
+{
+	return m_count;
+}
+
+int64_t FrameStats::getHitchCount() const
+{
+	return m_hitches;
+}
+
+void FrameStats::printReport(std::ostream& out) const
+{
+	out << "Frames: " << m_count << " | FPS medio: " << getAverageFps()
+		<< " | p50: " << getPercentile(50.0) << " ms | p95: " << getPercentile(95.0)
+		<< " ms | p99: " << getPercentile(99.0) << " ms | max: " << m_maxMs
+		<< " ms | travadas (> " << m_hitchMs << " ms): " << m_hitches << std::endl;
+	if (m_dropped > 0)
+	{
+		out << "Tempos descartados com o anel cheio: " << m_dropped << std::endl;
+	}
+}
+
+// Uma linha JSON, para scripts de benchmark
+void FrameStats::printJson(std::ostream& out) const
+{
+	out << "{\"frames\": " << m_count
+		<< ", \"average_fps\": " << getAverageFps()
+		<< ", \"p50_ms\": " << getPercentile(50.0)
+		<< ", \"p95_ms\": " << getPercentile(95.0)
+		<< ", \"p99_ms\": " << getPercentile(99.0)
+		<< ", \"max_ms\": " << m_maxMs
+		<< ", \"hitch_ms\": " << m_hitchMs
+		<< ", \"hitches\": " << m_hitches
+		<< ", \"dropped\": " << m_dropped << "}" << std::endl;
+}
+
+// Ate SUB_BUCKET_COUNT us a faixa e exata; acima, cada potencia de 2 tem
+// SUB_BUCKET_COUNT / 2 sub-faixas com os 7 bits mais altos do valor
+int FrameStats::bucketIndex(uint64_t microseconds)
+{
+	if (microseconds < SUB_BUCKET_COUNT)
+	{
+		return (int)microseconds;
+	}
+	int highestBit = 63;
+	while (!(microseconds >> highestBit))
+	{
+		highestBit--;
+	}
+	int shift = highestBit - (SUB_BUCKET_BITS - 1);
+	int subBucket = (int)(microseconds >> shift);
+	return SUB_BUCKET_COUNT + (shift - 1) * (SUB_BUCKET_COUNT / 2) + (subBucket - SUB_BUCKET_COUNT / 2);
+}
+
+// Meio da faixa, em us
+double FrameStats::bucketValue(int index)
+{
+	if (index < SUB_BUCKET_COUNT)
+	{
+		return index;
+	}
+	int shift = (index - SUB_BUCKET_COUNT) / (SUB_BUCKET_COUNT / 2) + 1;
+	int subBucket = (index - SUB_BUCKET_COUNT) % (SUB_BUCKET_COUNT / 2) + SUB_BUCKET_COUNT / 2;
+	return (subBucket + 0.5) * std::ldexp(1.0, shift);
+}
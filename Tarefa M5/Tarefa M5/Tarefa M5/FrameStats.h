@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Estatisticas dos tempos de frame. A thread que apresenta os frames chama record()
+// a cada swap e escreve num anel sem lock (um produtor, um consumidor); a thread
+// principal chama collect() para passar os tempos do anel para um histograma no
+// estilo HDR: faixas em potencias de 2 com 64 sub-faixas lineares cada, entao os
+// percentis tem erro relativo abaixo de 1.6% para qualquer tempo, de 1 us a minutos,
+// com memoria fixa. Maximo, soma e travadas (frames acima do limite) sao exatos.
+class FrameStats
+{
+public:
+	static const int RING_SIZE = 1024;
+	FrameStats(double hitchMs = 1000.0 / 30.0);
+	void record(double frameMs);
+	void collect();
+	void reset();
+	double getPercentile(double percentile) const;
+	double getMaxMs() const;
+	double getAverageFps() const;
+	int64_t getFrameCount() const;
+	int64_t getHitchCount() const;
+	void printReport(std::ostream& out) const;
+	void printJson(std::ostream& out) const;
+private:
+	static const int SUB_BUCKET_BITS = 7;
+	static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+	static const int BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * (SUB_BUCKET_COUNT / 2);
+	static int bucketIndex(uint64_t microseconds);
+	static double bucketValue(int index);
+	double m_hitchMs;
+	//anel: so record() escreve m_head, so collect() escreve m_tail
+	double m_ring[RING_SIZE];
+	std::atomic<uint32_t> m_head{ 0 };
+	std::atomic<uint32_t> m_tail{ 0 };
+	std::atomic<int64_t> m_dropped{ 0 };
+	std::vector<int64_t> m_buckets;
+	int64_t m_count = 0;
+	int64_t m_hitches = 0;
+	double m_sumMs = 0.0;
+	double m_maxMs = 0.0;
+};
@@ -0,0 +1,30 @@
+#include "FrameUniforms.h"
+
+FrameUniforms::FrameUniforms()
+{
+	glGenBuffers(1, &UBO);
+	glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, UBO);
+}
+
+void FrameUniforms::attach(const ShaderProgram& shader) const
+{
+	shader.bindUniformBlock("FrameData", BINDING_POINT);
+}
+
+void FrameUniforms::update(const glm::mat4& projection, float time)
+{
+	FrameData data;
+	data.projection = projection;
+	data.time = time;
+	glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::deleteBuffer()
+{
+	glDeleteBuffers(1, &UBO);
+}
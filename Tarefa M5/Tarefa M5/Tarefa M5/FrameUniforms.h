@@ -0,0 +1,30 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include "ShaderProgram.h"
+
+// Dados constantes durante o frame, compartilhados por todos os shaders atraves
+// de um uniform buffer. Precisa bater com o layout std140 do bloco FrameData:
+//
+// layout (std140) uniform FrameData
+// {
+//     mat4 projection;
+//     float time;
+// };
+class FrameUniforms
+{
+public:
+	static const GLuint BINDING_POINT = 0;
+	FrameUniforms();
+	void attach(const ShaderProgram& shader) const;
+	void update(const glm::mat4& projection, float time);
+	void deleteBuffer();
+private:
+	struct FrameData
+	{
+		glm::mat4 projection;
+		float time;
+		float padding[3];
+	};
+	GLuint UBO;
+};
@@ -0,0 +1,311 @@
+#include "GLInstrumentation.h"
+#include "dependencies/glfw/include/GLFW/glfw3.h"
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+static GLCallCounts s_counts;
+
+//objeto vinculado em cada ponto, para achar binds redundantes
+static GLuint s_program = 0;
+static GLuint s_vertexArray = 0;
+static GLenum s_activeTexture = GL_TEXTURE0;
+static std::unordered_map<unsigned long long, GLuint> s_textures;
+static std::unordered_map<unsigned long long, GLuint> s_buffers;
+
+static void countBind(GLuint current, GLuint object)
+{
+	if (object == 0)
+	{
+		s_counts.unbinds++;
+	}
+	else if (object == current)
+	{
+		s_counts.redundantBinds++;
+	}
+}
+
+static void countBind(std::unordered_map<unsigned long long, GLuint>& bindings, unsigned long long point, GLuint object)
+{
+	auto binding = bindings.find(point);
+	countBind(binding != bindings.end() ? binding->second : 0, object);
+	bindings[point] = object;
+}
+
+static PFNGLDRAWARRAYSPROC realDrawArrays;
+static void APIENTRY countedDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	s_counts.drawCalls++;
+	realDrawArrays(mode, first, count);
+}
+
+static PFNGLDRAWELEMENTSPROC realDrawElements;
+static void APIENTRY countedDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+	s_counts.drawCalls++;
+	realDrawElements(mode, count, type, indices);
+}
+
+static PFNGLDRAWRANGEELEMENTSPROC realDrawRangeElements;
+static void APIENTRY countedDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void* indices)
+{
+	s_counts.drawCalls++;
+	realDrawRangeElements(mode, start, end, count, type, indices);
+}
+
+static PFNGLDRAWARRAYSINSTANCEDPROC realDrawArraysInstanced;
+static void APIENTRY countedDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount)
+{
+	s_counts.drawCalls++;
+	realDrawArraysInstanced(mode, first, count, instanceCount);
+}
+
+static PFNGLDRAWELEMENTSINSTANCEDPROC realDrawElementsInstanced;
+static void APIENTRY countedDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount)
+{
+	s_counts.drawCalls++;
+	realDrawElementsInstanced(mode, count, type, indices, instanceCount);
+}
+
+static PFNGLDRAWELEMENTSBASEVERTEXPROC realDrawElementsBaseVertex;
+static void APIENTRY countedDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint baseVertex)
+{
+	s_counts.drawCalls++;
+	realDrawElementsBaseVertex(mode, count, type, indices, baseVertex);
+}
+
+static PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC realDrawElementsInstancedBaseVertex;
+static void APIENTRY countedDrawElementsInstancedBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instanceCount, GLint baseVertex)
+{
+	s_counts.drawCalls++;
+	realDrawElementsInstancedBaseVertex(mode, count, type, indices, instanceCount, baseVertex);
+}
+
+static PFNGLUSEPROGRAMPROC realUseProgram;
+static void APIENTRY countedUseProgram(GLuint program)
+{
+	s_counts.programBinds++;
+	countBind(s_program, program);
+	s_program = program;
+	realUseProgram(program);
+}
+
+static PFNGLBINDVERTEXARRAYPROC realBindVertexArray;
+static void APIENTRY countedBindVertexArray(GLuint vertexArray)
+{
+	s_counts.vertexArrayBinds++;
+	countBind(s_vertexArray, vertexArray);
+	s_vertexArray = vertexArray;
+	//o GL_ELEMENT_ARRAY_BUFFER faz parte do estado do VAO
+	s_buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+	realBindVertexArray(vertexArray);
+}
+
+static PFNGLACTIVETEXTUREPROC realActiveTexture;
+static void APIENTRY countedActiveTexture(GLenum texture)
+{
+	s_activeTexture = texture;
+	realActiveTexture(texture);
+}
+
+static PFNGLBINDTEXTUREPROC realBindTexture;
+static void APIENTRY countedBindTexture(GLenum target, GLuint texture)
+{
+	s_counts.textureBinds++;
+	countBind(s_textures, ((unsigned long long)s_activeTexture << 32) | target, texture);
+	realBindTexture(target, texture);
+}
+
+static PFNGLBINDBUFFERPROC realBindBuffer;
+static void APIENTRY countedBindBuffer(GLenum target, GLuint buffer)
+{
+	s_counts.bufferBinds++;
+	countBind(s_buffers, target, buffer);
+	realBindBuffer(target, buffer);
+}
+
+static PFNGLBINDBUFFERBASEPROC realBindBufferBase;
+static void APIENTRY countedBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+	s_counts.bufferBinds++;
+	realBindBufferBase(target, index, buffer);
+}
+
+static PFNGLBINDBUFFERRANGEPROC realBindBufferRange;
+static void APIENTRY countedBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+	s_counts.bufferBinds++;
+	realBindBufferRange(target, index, buffer, offset, size);
+}
+
+static PFNGLBUFFERDATAPROC realBufferData;
+static void APIENTRY countedBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+	if (data)
+	{
+		s_counts.bufferUploadBytes += size;
+	}
+	realBufferData(target, size, data, usage);
+}
+
+static PFNGLBUFFERSUBDATAPROC realBufferSubData;
+static void APIENTRY countedBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+	s_counts.bufferUploadBytes += size;
+	realBufferSubData(target, offset, size, data);
+}
+
+//trechos mapeados para escrita contam como enviados (o StreamBuffer persistente
+//escreve sem mapear de novo, entao fica de fora)
+static PFNGLMAPBUFFERRANGEPROC realMapBufferRange;
+static void* APIENTRY countedMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+	if ((access & GL_MAP_WRITE_BIT) && !(access & GL_MAP_PERSISTENT_BIT))
+	{
+		s_counts.bufferUploadBytes += length;
+	}
+	return realMapBufferRange(target, offset, length, access);
+}
+
+//os uniforms so contam as chamadas, com a mesma assinatura repassada
+#define COUNTED_UNIFORM(name, PROC, parameters, arguments) \
+	static PROC real##name; \
+	static void APIENTRY counted##name parameters \
+	{ \
+		s_counts.uniformUploads++; \
+		real##name arguments; \
+	}
+
+COUNTED_UNIFORM(Uniform1i, PFNGLUNIFORM1IPROC, (GLint location, GLint v0), (location, v0))
+COUNTED_UNIFORM(Uniform2i, PFNGLUNIFORM2IPROC, (GLint location, GLint v0, GLint v1), (location, v0, v1))
+COUNTED_UNIFORM(Uniform1f, PFNGLUNIFORM1FPROC, (GLint location, GLfloat v0), (location, v0))
+COUNTED_UNIFORM(Uniform2f, PFNGLUNIFORM2FPROC, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+COUNTED_UNIFORM(Uniform3f, PFNGLUNIFORM3FPROC, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2))
+COUNTED_UNIFORM(Uniform4f, PFNGLUNIFORM4FPROC, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3))
+COUNTED_UNIFORM(Uniform1iv, PFNGLUNIFORM1IVPROC, (GLint location, GLsizei count, const GLint* value), (location, count, value))
+COUNTED_UNIFORM(Uniform4fv, PFNGLUNIFORM4FVPROC, (GLint location, GLsizei count, const GLfloat* value), (location, count, value))
+COUNTED_UNIFORM(UniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value))
+
+#define INSTALL(name) \
+	real##name = glad_gl##name; \
+	glad_gl##name = counted##name
+
+void installGLCallCounters()
+{
+	static bool installed = false;
+	if (installed)
+	{
+		return;
+	}
+	installed = true;
+	INSTALL(DrawArrays);
+	INSTALL(DrawElements);
+	INSTALL(DrawRangeElements);
+	INSTALL(DrawArraysInstanced);
+	INSTALL(DrawElementsInstanced);
+	INSTALL(DrawElementsBaseVertex);
+	INSTALL(DrawElementsInstancedBaseVertex);
+	INSTALL(UseProgram);
+	INSTALL(BindVertexArray);
+	INSTALL(ActiveTexture);
+	INSTALL(BindTexture);
+	INSTALL(BindBuffer);
+	INSTALL(BindBufferBase);
+	INSTALL(BindBufferRange);
+	INSTALL(BufferData);
+	INSTALL(BufferSubData);
+	INSTALL(MapBufferRange);
+	INSTALL(Uniform1i);
+	INSTALL(Uniform2i);
+	INSTALL(Uniform1f);
+	INSTALL(Uniform2f);
+	INSTALL(Uniform3f);
+	INSTALL(Uniform4f);
+	INSTALL(Uniform1iv);
+	INSTALL(Uniform4fv);
+	INSTALL(UniformMatrix4fv);
+}
+
+static const char* debugTypeName(GLenum type)
+{
+	switch (type)
+	{
+	case GL_DEBUG_TYPE_ERROR: return "erro";
+	case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "obsoleto";
+	case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "comportamento indefinido";
+	case GL_DEBUG_TYPE_PORTABILITY: return "portabilidade";
+	case GL_DEBUG_TYPE_PERFORMANCE: return "desempenho";
+	default: return "outro";
+	}
+}
+
+static const char* debugSeverityName(GLenum severity)
+{
+	switch (severity)
+	{
+	case GL_DEBUG_SEVERITY_HIGH: return "alta";
+	case GL_DEBUG_SEVERITY_MEDIUM: return "media";
+	case GL_DEBUG_SEVERITY_LOW: return "baixa";
+	default: return "aviso";
+	}
+}
+
+static void APIENTRY debugMessage(GLenum, GLenum type, GLuint id, GLenum severity, GLsizei, const GLchar* message, const void*)
+{
+	if (type == GL_DEBUG_TYPE_PERFORMANCE)
+	{
+		s_counts.performanceWarnings++;
+	}
+	std::cerr << "GL (" << debugTypeName(type) << ", " << debugSeverityName(severity) << ", id " << id << "): " << message << std::endl;
+}
+
+// O loader da glad so carrega ate a OpenGL 3.3, entao as funcoes de debug vem da GLFW
+bool enableGLDebugOutput()
+{
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	bool supported = major > 4 || (major == 4 && minor >= 3);
+	GLint extensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+	for (GLint i = 0; i < extensionCount && !supported; i++)
+	{
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		supported = std::strcmp(extension, "GL_KHR_debug") == 0;
+	}
+	PFNGLDEBUGMESSAGECALLBACKPROC debugMessageCallback = supported ? (PFNGLDEBUGMESSAGECALLBACKPROC)glfwGetProcAddress("glDebugMessageCallback") : nullptr;
+	PFNGLDEBUGMESSAGECONTROLPROC debugMessageControl = supported ? (PFNGLDEBUGMESSAGECONTROLPROC)glfwGetProcAddress("glDebugMessageControl") : nullptr;
+	if (!debugMessageCallback || !debugMessageControl)
+	{
+		std::cerr << "Erro ao ligar a saida de debug: contexto sem GL_KHR_debug" << std::endl;
+		return false;
+	}
+	glEnable(GL_DEBUG_OUTPUT);
+	//a mensagem sai dentro da chamada que a causou
+	glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	debugMessageCallback(debugMessage, nullptr);
+	//as notificacoes sao so informativas e saem a cada frame
+	debugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+	return true;
+}
+
+GLCallCounts takeGLCallCounts()
+{
+	GLCallCounts counts = s_counts;
+	s_counts = GLCallCounts();
+	return counts;
+}
+
+void printGLCallCounts(std::ostream& out, const GLCallCounts& counts)
+{
+	out << "GL por frame: draws " << counts.drawCalls
+		<< " | programas " << counts.programBinds
+		<< " | VAOs " << counts.vertexArrayBinds
+		<< " | buffers " << counts.bufferBinds
+		<< " | texturas " << counts.textureBinds
+		<< " | desvinculos " << counts.unbinds
+		<< " | redundantes " << counts.redundantBinds
+		<< " | uniforms " << counts.uniformUploads
+		<< " | bytes enviados " << counts.bufferUploadBytes
+		<< " | avisos de desempenho " << counts.performanceWarnings << std::endl;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <glad/glad.h>
+#include <ostream>
+
+// Contadores de chamadas OpenGL de um frame. "Desvinculos" sao binds do objeto 0 e
+// "redundantes" sao binds do objeto que ja estava vinculado.
+struct GLCallCounts
+{
+	int drawCalls = 0;
+	int programBinds = 0;
+	int vertexArrayBinds = 0;
+	int bufferBinds = 0;
+	int textureBinds = 0;
+	int unbinds = 0;
+	int redundantBinds = 0;
+	int uniformUploads = 0;
+	long long bufferUploadBytes = 0;
+	int performanceWarnings = 0;
+};
+
+// Troca os ponteiros carregados pela glad (Common/glad.c) de draws, binds, uniforms
+// e envios de buffer por versoes que contam as chamadas e repassam para o driver.
+// Deve ser chamada logo depois do gladLoadGLLoader, na thread do contexto; os
+// contadores nao tem lock, entao todas as chamadas OpenGL devem vir dessa thread.
+void installGLCallCounters();
+
+// Liga a saida de GL_KHR_debug (OpenGL 4.3 ou a extensao) e manda as mensagens
+// do driver para o std::cerr, contando os avisos de desempenho. Retorna false se
+// o contexto nao tem KHR_debug. Funciona melhor com GLFW_OPENGL_DEBUG_CONTEXT.
+bool enableGLDebugOutput();
+
+// Devolve os contadores desde a ultima chamada e zera
+GLCallCounts takeGLCallCounts();
+
+void printGLCallCounts(std::ostream& out, const GLCallCounts& counts);
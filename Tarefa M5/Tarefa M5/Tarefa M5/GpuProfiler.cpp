@@ -0,0 +1,133 @@
+#include "GpuProfiler.h"
+
+GpuProfiler::GpuProfiler()
+{
+	for (Frame& frame : m_frames)
+	{
+		glGenQueries(MAX_SCOPES, frame.queries);
+	}
+}
+
+// Retorna true se algum frame anterior foi lido (getResults mudou)
+bool GpuProfiler::beginFrame()
+{
+	m_collected = false;
+	// Le, do mais antigo para o mais novo, os frames cujas queries ja terminaram
+	for (int i = 1; i <= FRAME_LATENCY; i++)
+	{
+		Frame& frame = m_frames[(m_current + i) % FRAME_LATENCY];
+		if (frame.pending && isAvailable(frame))
+		{
+			collect(frame);
+		}
+	}
+	m_current = (m_current + 1) % FRAME_LATENCY;
+	Frame& frame = m_frames[m_current];
+	// A GPU esta mais de FRAME_LATENCY frames atrasada: aqui a leitura precisa esperar
+	if (frame.pending)
+	{
+		m_stallCount++;
+		collect(frame);
+	}
+	frame.scopeCount = 0;
+	frame.queryCount = 0;
+	return m_collected;
+}
+
+void GpuProfiler::beginScope(const char* name)
+{
+	Frame& frame = m_frames[m_current];
+	if (m_scopeOpen || frame.scopeCount == MAX_SCOPES)
+	{
+		return;
+	}
+	Scope& scope = frame.scopes[frame.scopeCount];
+	scope.name = name;
+	frame.scopeQueries[frame.scopeCount] = frame.queryCount;
+	glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.queryCount]);
+	m_scopeOpen = true;
+	m_scopeStart = std::chrono::steady_clock::now();
+}
+
+void GpuProfiler::endScope(int drawCount)
+{
+	if (!m_scopeOpen)
+	{
+		return;
+	}
+	Frame& frame = m_frames[m_current];
+	Scope& scope = frame.scopes[frame.scopeCount++];
+	scope.cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_scopeStart).count();
+	scope.drawCount = drawCount;
+	glEndQuery(GL_TIME_ELAPSED);
+	frame.queryCount++;
+	frame.pending = true;
+	m_scopeOpen = false;
+}
+
+// Tempo medido fora do contexto (por exemplo, a simulacao na outra thread), mostrado
+// junto com os passes do mesmo frame
+void GpuProfiler::addCpuScope(const char* name, double cpuMs)
+{
+	Frame& frame = m_frames[m_current];
+	if (m_scopeOpen || frame.scopeCount == MAX_SCOPES)
+	{
+		return;
+	}
+	frame.scopeQueries[frame.scopeCount] = -1;
+	Scope& scope = frame.scopes[frame.scopeCount++];
+	scope.name = name;
+	scope.gpuMs = -1.0;
+	scope.cpuMs = cpuMs;
+	scope.drawCount = 0;
+	frame.pending = true;
+}
+
+// Ultimo frame completo lido
+const std::vector<GpuProfiler::Scope>& GpuProfiler::getResults() const
+{
+	return m_results;
+}
+
+// Quantas vezes a leitura teve que esperar a GPU
+int GpuProfiler::getStallCount() const
+{
+	return m_stallCount;
+}
+
+void GpuProfiler::deleteQueries()
+{
+	for (Frame& frame : m_frames)
+	{
+		glDeleteQueries(MAX_SCOPES, frame.queries);
+	}
+}
+
+// As queries terminam em ordem, entao basta olhar a ultima do frame
+bool GpuProfiler::isAvailable(const Frame& frame) const
+{
+	if (frame.queryCount == 0)
+	{
+		return true;
+	}
+	GLint available = 0;
+	glGetQueryObjectiv(frame.queries[frame.queryCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	return available != 0;
+}
+
+void GpuProfiler::collect(Frame& frame)
+{
+	m_results.assign(frame.scopes, frame.scopes + frame.scopeCount);
+	for (int i = 0; i < frame.scopeCount; i++)
+	{
+		if (frame.scopeQueries[i] < 0)
+		{
+			continue;
+		}
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(frame.queries[frame.scopeQueries[i]], GL_QUERY_RESULT, &elapsed);
+		m_results[i].gpuMs = elapsed / 1000000.0;
+	}
+	frame.pending = false;
+	m_collected = true;
+}
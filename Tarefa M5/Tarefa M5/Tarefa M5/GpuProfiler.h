@@ -0,0 +1,53 @@
+#pragma once
+#include <glad/glad.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Mede quanto cada passe de desenho custa na GPU com queries GL_TIME_ELAPSED, junto
+// com o tempo de CPU gasto para envia-lo e o numero de draw calls. As queries de um
+// frame so sao lidas FRAME_LATENCY frames depois (quando GL_QUERY_RESULT_AVAILABLE
+// ja diz que terminaram), entao a leitura nao para o pipeline esperando a GPU.
+// Escopos GL_TIME_ELAPSED nao podem ser aninhados: um passe termina antes do proximo.
+class GpuProfiler
+{
+public:
+	static const int FRAME_LATENCY = 4;
+	static const int MAX_SCOPES = 8;
+	struct Scope
+	{
+		std::string name;
+		// gpuMs fica negativo nos escopos so de CPU (addCpuScope)
+		double gpuMs = -1.0;
+		double cpuMs = 0.0;
+		int drawCount = 0;
+	};
+	GpuProfiler();
+	bool beginFrame();
+	void beginScope(const char* name);
+	void endScope(int drawCount);
+	void addCpuScope(const char* name, double cpuMs);
+	const std::vector<Scope>& getResults() const;
+	int getStallCount() const;
+	void deleteQueries();
+private:
+	struct Frame
+	{
+		GLuint queries[MAX_SCOPES];
+		Scope scopes[MAX_SCOPES];
+		//query de cada escopo, -1 nos escopos so de CPU
+		int scopeQueries[MAX_SCOPES];
+		int scopeCount = 0;
+		int queryCount = 0;
+		bool pending = false;
+	};
+	bool isAvailable(const Frame& frame) const;
+	void collect(Frame& frame);
+	Frame m_frames[FRAME_LATENCY];
+	int m_current = 0;
+	bool m_scopeOpen = false;
+	std::chrono::steady_clock::time_point m_scopeStart;
+	std::vector<Scope> m_results;
+	int m_stallCount = 0;
+	bool m_collected = false;
+};
@@ -0,0 +1,53 @@
+#include "ImageFile.h"
+#include "stb/stb_image.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+bool saveImagePPM(const char* path, const std::vector<unsigned char>& rgb, int width, int height)
+{
+	FILE* file = std::fopen(path, "wb");
+	if (!file)
+	{
+		std::cerr << "Erro ao salvar imagem: " << path << std::endl;
+		return false;
+	}
+	std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+	std::fwrite(rgb.data(), 1, rgb.size(), file);
+	std::fclose(file);
+	return true;
+}
+
+bool matchesReference(const std::vector<unsigned char>& rgb, int width, int height, const char* referencePath, int tolerance)
+{
+	int referenceWidth, referenceHeight, numChannels;
+	stbi_set_flip_vertically_on_load(false);
+	unsigned char* reference = stbi_load(referencePath, &referenceWidth, &referenceHeight, &numChannels, STBI_rgb);
+	if (!reference)
+	{
+		std::cerr << "Erro ao carregar imagem de referencia: " << referencePath << std::endl;
+		return false;
+	}
+	if (referenceWidth != width || referenceHeight != height)
+	{
+		std::cerr << "Imagem de referencia com tamanho diferente: " << referencePath << std::endl;
+		stbi_image_free(reference);
+		return false;
+	}
+	int differentPixels = 0;
+	int maxDelta = 0;
+	for (int i = 0; i < width * height; i++)
+	{
+		bool different = false;
+		for (int channel = 0; channel < 3; channel++)
+		{
+			int delta = std::abs(rgb[i * 3 + channel] - reference[i * 3 + channel]);
+			maxDelta = delta > maxDelta ? delta : maxDelta;
+			different = different || delta > tolerance;
+		}
+		differentPixels += different ? 1 : 0;
+	}
+	stbi_image_free(reference);
+	std::cout << "Comparacao com " << referencePath << ": " << differentPixels << " pixels diferentes, maior diferenca " << maxDelta << std::endl;
+	return differentPixels == 0;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <vector>
+
+// Leitura e escrita das imagens dos modos sem janela. Os pixels sao RGB, da linha
+// de cima para a de baixo (a ordem do PPM).
+bool saveImagePPM(const char* path, const std::vector<unsigned char>& rgb, int width, int height);
+
+// Compara com a imagem de referencia: um pixel conta como diferente se algum canal
+// passar da tolerancia. Passa so se nenhum pixel for diferente.
+bool matchesReference(const std::vector<unsigned char>& rgb, int width, int height, const char* referencePath, int tolerance);
@@ -0,0 +1,130 @@
+#include "MeshRegistry.h"
+#include <iostream>
+
+const char* MeshRegistry::UNIT_QUAD = "unit_quad";
+std::vector<Mesh> MeshRegistry::m_meshes;
+std::unordered_map<std::string, int> MeshRegistry::m_meshByName;
+
+void MeshRegistry::registerMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<GLuint>& indices)
+{
+	auto found = m_meshByName.find(name);
+	if (found != m_meshByName.end())
+	{
+		//Trocar os dados de uma malha em uso invalidaria os buffers dos sprites
+		if (m_meshes[found->second].refCount > 0)
+		{
+			std::cerr << "Malha em uso, nao pode ser registrada de novo: " << name << std::endl;
+			return;
+		}
+		m_meshes[found->second].vertices = vertices;
+		m_meshes[found->second].indices = indices;
+		return;
+	}
+	Mesh mesh;
+	mesh.vertices = vertices;
+	mesh.indices = indices;
+	m_meshByName[name] = (int)m_meshes.size();
+	m_meshes.push_back(mesh);
+}
+
+// Malha no lugar do quad unitario a partir de um poligono convexo em coordenadas de
+// textura [0,1] (como o de computeAlphaHull), triangulado em leque
+void MeshRegistry::registerPolygon(const std::string& name, const std::vector<glm::vec2>& outline)
+{
+	std::vector<float> vertices;
+	for (const glm::vec2& point : outline)
+	{
+		//posicao					//cor				//coordenada de textura
+		vertices.insert(vertices.end(), { point.x - 0.5f, point.y - 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, point.x, point.y });
+	}
+	std::vector<GLuint> indices;
+	for (GLuint i = 1; i + 1 < (GLuint)outline.size(); i++)
+	{
+		indices.insert(indices.end(), { 0, i, i + 1 });
+	}
+	registerMesh(name, vertices, indices);
+}
+
+int MeshRegistry::acquire(const std::string& name)
+{
+	if (m_meshByName.find(UNIT_QUAD) == m_meshByName.end())
+	{
+		registerUnitQuad();
+	}
+	auto found = m_meshByName.find(name);
+	if (found == m_meshByName.end())
+	{
+		std::cerr << "Malha nao registrada: " << name << ", usando o quad unitario" << std::endl;
+		found = m_meshByName.find(UNIT_QUAD);
+	}
+	Mesh& mesh = m_meshes[found->second];
+	if (mesh.refCount == 0)
+	{
+		upload(mesh);
+	}
+	mesh.refCount++;
+	return found->second;
+}
+
+void MeshRegistry::release(int meshID)
+{
+	if (meshID < 0)
+	{
+		return;
+	}
+	Mesh& mesh = m_meshes[meshID];
+	if (mesh.refCount == 0)
+	{
+		return;
+	}
+	mesh.refCount--;
+	if (mesh.refCount == 0)
+	{
+		glDeleteVertexArrays(1, &mesh.VAO);
+		glDeleteBuffers(1, &mesh.VBO);
+		glDeleteBuffers(1, &mesh.EBO);
+		mesh.VAO = mesh.VBO = mesh.EBO = 0;
+	}
+}
+
+const Mesh& MeshRegistry::getMesh(int meshID)
+{
+	return m_meshes[meshID];
+}
+
+void MeshRegistry::registerUnitQuad()
+{
+	registerMesh(UNIT_QUAD, {
+		//posicoes			//cores				//coordenadas de textura
+		0.5, 0.5, 0.0,		0.0, 0.0, 0.0,		1.0, 1.0,
+		-0.5, -0.5, 0.0,	0.0, 0.0, 0.0,		0.0, 0.0,
+		0.5, -0.5, 0.0,		0.0, 0.0, 0.0,		1.0, 0.0,
+		-0.5, 0.5, 0.0,		0.0, 0.0, 0.0,		0.0, 1.0
+	}, {
+		0, 1, 2,//primeiro triangulo
+		0, 3, 1 //segundo triangulo
+	});
+}
+
+void MeshRegistry::upload(Mesh& mesh)
+{
+	glGenVertexArrays(1, &mesh.VAO);
+	glBindVertexArray(mesh.VAO);
+	glGenBuffers(1, &mesh.VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+	glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float), mesh.vertices.data(), GL_STATIC_DRAW);
+	//atributo de posicao
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	//atributo de cor
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	//atributo de coordenada de textura
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+	glEnableVertexAttribArray(2);
+	glGenBuffers(1, &mesh.EBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(GLuint), mesh.indices.data(), GL_STATIC_DRAW);
+	glBindVertexArray(0);
+	mesh.indexCount = (GLsizei)mesh.indices.size();
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Malha compartilhada entre sprites. Os vertices usam o layout do Sprite:
+// posicao (3 floats), cor (3 floats) e coordenada de textura (2 floats)
+struct Mesh
+{
+	std::vector<float> vertices;
+	std::vector<GLuint> indices;
+	GLuint VAO = 0;
+	GLuint VBO = 0;
+	GLuint EBO = 0;
+	GLsizei indexCount = 0;
+	int refCount = 0;
+};
+
+// Registro de malhas com contagem de referencias: a malha so vai para a GPU no
+// primeiro acquire e os buffers sao liberados quando o ultimo usuario faz release.
+// O quad unitario ja vem registrado com o nome UNIT_QUAD.
+class MeshRegistry
+{
+public:
+	static const char* UNIT_QUAD;
+	static void registerMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<GLuint>& indices);
+	static void registerPolygon(const std::string& name, const std::vector<glm::vec2>& outline);
+	static int acquire(const std::string& name);
+	static void release(int meshID);
+	static const Mesh& getMesh(int meshID);
+private:
+	static void registerUnitQuad();
+	static void upload(Mesh& mesh);
+	static std::vector<Mesh> m_meshes;
+	static std::unordered_map<std::string, int> m_meshByName;
+};
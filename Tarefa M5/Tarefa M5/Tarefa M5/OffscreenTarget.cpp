@@ -0,0 +1,74 @@
+#include "OffscreenTarget.h"
+#include "ImageFile.h"
+#include <iostream>
+
+OffscreenTarget::OffscreenTarget(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glGenRenderbuffers(1, &m_depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &FBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cerr << "Erro ao criar o framebuffer offscreen" << std::endl;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void OffscreenTarget::bind() const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	glViewport(0, 0, m_width, m_height);
+}
+
+// Pixels RGB da imagem, da linha de cima para a de baixo (a ordem do PPM)
+void OffscreenTarget::readPixels(std::vector<unsigned char>& rgb) const
+{
+	std::vector<unsigned char> rgba(m_width * m_height * 4);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+	rgb.resize(m_width * m_height * 3);
+	for (int y = 0; y < m_height; y++)
+	{
+		const unsigned char* source = &rgba[(m_height - 1 - y) * m_width * 4];
+		unsigned char* destination = &rgb[y * m_width * 3];
+		for (int x = 0; x < m_width; x++)
+		{
+			destination[x * 3 + 0] = source[x * 4 + 0];
+			destination[x * 3 + 1] = source[x * 4 + 1];
+			destination[x * 3 + 2] = source[x * 4 + 2];
+		}
+	}
+}
+
+bool OffscreenTarget::save(const char* path) const
+{
+	std::vector<unsigned char> rgb;
+	readPixels(rgb);
+	return saveImagePPM(path, rgb, m_width, m_height);
+}
+
+bool OffscreenTarget::matches(const char* referencePath, int tolerance) const
+{
+	std::vector<unsigned char> rgb;
+	readPixels(rgb);
+	return matchesReference(rgb, m_width, m_height, referencePath, tolerance);
+}
+
+void OffscreenTarget::deleteBuffers()
+{
+	glDeleteFramebuffers(1, &FBO);
+	glDeleteRenderbuffers(1, &m_colorBuffer);
+	glDeleteRenderbuffers(1, &m_depthBuffer);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+
+// Framebuffer proprio (cor RGBA8 + profundidade/stencil) para o modo --headless,
+// onde a janela nao tem superficie visivel. Depois de desenhar, o frame pode ser
+// salvo em PPM (P6) e comparado com uma imagem de referencia guardada (ImageFile.h).
+class OffscreenTarget
+{
+public:
+	OffscreenTarget(int width, int height);
+	void bind() const;
+	void readPixels(std::vector<unsigned char>& rgb) const;
+	bool save(const char* path) const;
+	bool matches(const char* referencePath, int tolerance) const;
+	void deleteBuffers();
+private:
+	int m_width;
+	int m_height;
+	GLuint FBO;
+	GLuint m_colorBuffer;
+	GLuint m_depthBuffer;
+};
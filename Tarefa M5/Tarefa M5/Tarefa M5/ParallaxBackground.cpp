@@ -0,0 +1,110 @@
+#include "ParallaxBackground.h"
+#include "stb/stb_image.h"
+#include <iostream>
+
+ParallaxBackground::ParallaxBackground(const ShaderProgram& shader)
+{
+	shaderID = shader.getID();
+	m_layerCountLoc = shader.getUniformLocation("layerCount");
+	m_layerTransformsLoc = shader.getUniformLocation("layerTransforms");
+
+	//cada camada le sempre da mesma unidade de textura
+	GLint units[MAX_LAYERS];
+	for (int i = 0; i < MAX_LAYERS; i++)
+	{
+		units[i] = i;
+	}
+	glUseProgram(shaderID);
+	glUniform1iv(shader.getUniformLocation("layerTextures"), MAX_LAYERS, units);
+
+	//quad de tela cheia em triangle strip, com coordenadas de tela em [0,1]
+	GLfloat vertices[] = {
+		0.0f, 0.0f,
+		1.0f, 0.0f,
+		0.0f, 1.0f,
+		1.0f, 1.0f
+	};
+	glGenVertexArrays(1, &VAO);
+	glBindVertexArray(VAO);
+	glGenBuffers(1, &VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	glBindVertexArray(0);
+}
+
+// scrollFactor 1 anda junto com o mundo, valores menores ficam mais "ao fundo".
+// tileSize e o tamanho de uma repeticao da imagem em coordenadas de mundo.
+int ParallaxBackground::addLayer(const char* path, float scrollFactor, glm::vec2 tileSize)
+{
+	if ((int)m_layers.size() == MAX_LAYERS)
+	{
+		std::cerr << "Limite de camadas do fundo atingido: " << path << std::endl;
+		return -1;
+	}
+	Layer layer;
+	layer.scrollFactor = scrollFactor;
+	layer.tileSize = tileSize;
+	glGenTextures(1, &layer.textureID);
+	glBindTexture(GL_TEXTURE_2D, layer.textureID);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	int width, height, numChannels;
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* data = stbi_load(path, &width, &height, &numChannels, STBI_rgb_alpha);
+	if (data)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+		glGenerateMipmap(GL_TEXTURE_2D);
+	}
+	else
+	{
+		std::cerr << "Erro ao carregar textura: " << path << std::endl;
+	}
+	stbi_image_free(data);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	m_layers.push_back(layer);
+	return (int)m_layers.size() - 1;
+}
+
+void ParallaxBackground::draw(const Camera2D& camera)
+{
+	if (m_layers.empty())
+	{
+		return;
+	}
+	//xy: quantas repeticoes da camada cabem na vista, zw: scrollOffset da camada
+	glm::vec4 transforms[MAX_LAYERS];
+	for (int i = 0; i < (int)m_layers.size(); i++)
+	{
+		const Layer& layer = m_layers[i];
+		transforms[i] = glm::vec4(camera.getSize() / layer.tileSize, camera.getPosition() * layer.scrollFactor / layer.tileSize);
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, layer.textureID);
+	}
+	glUseProgram(shaderID);
+	glUniform1i(m_layerCountLoc, (int)m_layers.size());
+	glUniform4fv(m_layerTransformsLoc, (int)m_layers.size(), &transforms[0][0]);
+	glBindVertexArray(VAO);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	glBindVertexArray(0);
+	for (int i = (int)m_layers.size() - 1; i >= 0; i--)
+	{
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+}
+
+void ParallaxBackground::deleteBuffers()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	for (Layer& layer : m_layers)
+	{
+		glDeleteTextures(1, &layer.textureID);
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include "ShaderProgram.h"
+#include "Camera2D.h"
+
+// Fundo com varias camadas que se repetem (GL_REPEAT) e andam com a camera em
+// velocidades diferentes. Todas as camadas sao desenhadas num quad de tela cheia,
+// com um sampler por camada: o fragment shader compoe as camadas de tras para
+// frente, entao nao ha um quad com blending para cada camada.
+class ParallaxBackground
+{
+public:
+	static const int MAX_LAYERS = 4;
+	ParallaxBackground(const ShaderProgram& shader);
+	int addLayer(const char* path, float scrollFactor, glm::vec2 tileSize);
+	void draw(const Camera2D& camera);
+	void deleteBuffers();
+private:
+	struct Layer
+	{
+		GLuint textureID;
+		float scrollFactor;
+		glm::vec2 tileSize;
+	};
+	std::vector<Layer> m_layers;
+	GLuint VAO;
+	GLuint VBO;
+	GLuint shaderID;
+	GLint m_layerCountLoc;
+	GLint m_layerTransformsLoc;
+};
@@ -0,0 +1,175 @@
+#include "ProfilerOverlay.h"
+#include <cstdio>
+#include <cstring>
+
+//fonte 3x5: uma linha por byte, de cima para baixo, bit 4 e a coluna da esquerda
+static const char* GLYPH_CHARACTERS = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ.:-/";
+static const unsigned char GLYPHS[][5] = {
+	{ 7, 5, 5, 5, 7 }, { 2, 6, 2, 2, 7 }, { 7, 1, 7, 4, 7 }, { 7, 1, 7, 1, 7 }, { 5, 5, 7, 1, 1 },
+	{ 7, 4, 7, 1, 7 }, { 7, 4, 7, 5, 7 }, { 7, 1, 1, 1, 1 }, { 7, 5, 7, 5, 7 }, { 7, 5, 7, 1, 7 },
+	{ 2, 5, 7, 5, 5 }, { 6, 5, 6, 5, 6 }, { 3, 4, 4, 4, 3 }, { 6, 5, 5, 5, 6 }, { 7, 4, 6, 4, 7 },
+	{ 7, 4, 6, 4, 4 }, { 3, 4, 5, 5, 3 }, { 5, 5, 7, 5, 5 }, { 7, 2, 2, 2, 7 }, { 1, 1, 1, 5, 2 },
+	{ 5, 5, 6, 5, 5 }, { 4, 4, 4, 4, 7 }, { 5, 7, 7, 5, 5 }, { 6, 5, 5, 5, 5 }, { 2, 5, 5, 5, 2 },
+	{ 6, 5, 6, 4, 4 }, { 2, 5, 5, 6, 3 }, { 6, 5, 6, 5, 5 }, { 3, 4, 2, 1, 6 }, { 7, 2, 2, 2, 2 },
+	{ 5, 5, 5, 5, 7 }, { 5, 5, 5, 5, 2 }, { 5, 5, 7, 7, 5 }, { 5, 5, 2, 5, 5 }, { 5, 5, 2, 2, 2 },
+	{ 7, 1, 2, 4, 7 }, { 0, 0, 0, 0, 2 }, { 0, 2, 0, 2, 0 }, { 0, 0, 7, 0, 0 }, { 1, 1, 2, 4, 4 }
+};
+
+//cor de cada passe, na ordem dos escopos do frame
+static const glm::vec4 SCOPE_COLORS[] = {
+	glm::vec4(0.30f, 0.75f, 0.35f, 1.0f),
+	glm::vec4(0.30f, 0.55f, 0.90f, 1.0f),
+	glm::vec4(0.95f, 0.65f, 0.20f, 1.0f),
+	glm::vec4(0.85f, 0.35f, 0.75f, 1.0f),
+	glm::vec4(0.90f, 0.30f, 0.30f, 1.0f),
+	glm::vec4(0.35f, 0.85f, 0.85f, 1.0f)
+};
+static const int SCOPE_COLOR_COUNT = sizeof(SCOPE_COLORS) / sizeof(SCOPE_COLORS[0]);
+
+static const float PANEL_X = 8.0f;
+static const float PANEL_Y = 8.0f;
+static const float PANEL_WIDTH = 300.0f;
+static const float PADDING = 6.0f;
+static const float GRAPH_HEIGHT = 80.0f;
+//o grafico vai ate 33.3 ms; a linha marca 16.7 ms (60 fps)
+static const float GRAPH_MAX_MS = 1000.0f / 30.0f;
+static const float PIXEL = 2.0f;
+static const float LINE_HEIGHT = 7.0f * PIXEL;
+
+ProfilerOverlay::ProfilerOverlay(const ShaderProgram& shader)
+{
+	shaderID = shader.getID();
+	m_screenSizeLoc = shader.getUniformLocation("screenSize");
+
+	//posicao (x, y) em pixels + cor (r, g, b, a)
+	glGenVertexArrays(1, &VAO);
+	glBindVertexArray(VAO);
+	glGenBuffers(1, &VBO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(2 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+}
+
+// Entra com cada frame novo lido pelo GpuProfiler
+void ProfilerOverlay::update(const std::vector<GpuProfiler::Scope>& scopes)
+{
+	m_latest = scopes;
+	std::vector<float> column;
+	for (const GpuProfiler::Scope& scope : scopes)
+	{
+		column.push_back(scope.gpuMs > 0.0 ? (float)scope.gpuMs : 0.0f);
+	}
+	m_history.push_back(column);
+	if ((int)m_history.size() > HISTORY)
+	{
+		m_history.pop_front();
+	}
+}
+
+void ProfilerOverlay::draw(int screenWidth, int screenHeight)
+{
+	m_vertices.clear();
+	float panelHeight = PADDING * 3.0f + GRAPH_HEIGHT + LINE_HEIGHT * (m_latest.size() + 1);
+	addRect(PANEL_X, PANEL_Y, PANEL_WIDTH, panelHeight, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+
+	//grafico: uma coluna por frame, com os passes empilhados de baixo para cima
+	float graphX = PANEL_X + PADDING;
+	float graphBottom = PANEL_Y + PADDING + GRAPH_HEIGHT;
+	float graphWidth = PANEL_WIDTH - PADDING * 2.0f;
+	float columnWidth = graphWidth / HISTORY;
+	float pixelsPerMs = GRAPH_HEIGHT / GRAPH_MAX_MS;
+	for (int i = 0; i < (int)m_history.size(); i++)
+	{
+		float x = graphX + (HISTORY - m_history.size() + i) * columnWidth;
+		float y = graphBottom;
+		for (int scope = 0; scope < (int)m_history[i].size(); scope++)
+		{
+			float height = m_history[i][scope] * pixelsPerMs;
+			if (y - height < graphBottom - GRAPH_HEIGHT)
+			{
+				height = y - (graphBottom - GRAPH_HEIGHT);
+			}
+			addRect(x, y - height, columnWidth, height, SCOPE_COLORS[scope % SCOPE_COLOR_COUNT]);
+			y -= height;
+		}
+	}
+	addRect(graphX, graphBottom - GRAPH_HEIGHT * 0.5f, graphWidth, 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+
+	//tabela: nome, GPU ms, CPU ms e draw calls do ultimo frame lido
+	glm::vec4 textColor(1.0f);
+	float y = graphBottom + PADDING;
+	addText(graphX, y, "PASSE", textColor);
+	addText(graphX + 120.0f, y, "GPU MS", textColor);
+	addText(graphX + 180.0f, y, "CPU MS", textColor);
+	addText(graphX + 240.0f, y, "DRAWS", textColor);
+	char text[32];
+	for (int i = 0; i < (int)m_latest.size(); i++)
+	{
+		const GpuProfiler::Scope& scope = m_latest[i];
+		y += LINE_HEIGHT;
+		addRect(graphX, y, 5.0f * PIXEL, 5.0f * PIXEL, SCOPE_COLORS[i % SCOPE_COLOR_COUNT]);
+		addText(graphX + 7.0f * PIXEL, y, scope.name, textColor);
+		if (scope.gpuMs >= 0.0)
+		{
+			std::snprintf(text, sizeof(text), "%.2f", scope.gpuMs);
+			addText(graphX + 120.0f, y, text, textColor);
+			std::snprintf(text, sizeof(text), "%d", scope.drawCount);
+			addText(graphX + 240.0f, y, text, textColor);
+		}
+		std::snprintf(text, sizeof(text), "%.2f", scope.cpuMs);
+		addText(graphX + 180.0f, y, text, textColor);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(GLfloat), m_vertices.data(), GL_STREAM_DRAW);
+	glUseProgram(shaderID);
+	glUniform2f(m_screenSizeLoc, (float)screenWidth, (float)screenHeight);
+	glBindVertexArray(VAO);
+	glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(m_vertices.size() / 6));
+	glBindVertexArray(0);
+}
+
+void ProfilerOverlay::deleteBuffers()
+{
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+}
+
+void ProfilerOverlay::addRect(float x, float y, float width, float height, const glm::vec4& color)
+{
+	const float corners[6][2] = {
+		{ x, y }, { x + width, y }, { x, y + height },
+		{ x + width, y }, { x + width, y + height }, { x, y + height }
+	};
+	for (const float* corner : corners)
+	{
+		m_vertices.insert(m_vertices.end(), { corner[0], corner[1], color.r, color.g, color.b, color.a });
+	}
+}
+
+// Cada pixel aceso da fonte vira um quadrado de PIXEL x PIXEL
+void ProfilerOverlay::addText(float x, float y, const std::string& text, const glm::vec4& color)
+{
+	for (char character : text)
+	{
+		const char* glyph = character != '\0' ? std::strchr(GLYPH_CHARACTERS, character) : nullptr;
+		if (glyph)
+		{
+			const unsigned char* rows = GLYPHS[glyph - GLYPH_CHARACTERS];
+			for (int row = 0; row < 5; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					if (rows[row] & (4 >> column))
+					{
+						addRect(x + column * PIXEL, y + row * PIXEL, PIXEL, PIXEL, color);
+					}
+				}
+			}
+		}
+		x += 4.0f * PIXEL;
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+#include "ShaderProgram.h"
+#include "GpuProfiler.h"
+
+// Painel desenhado por cima da cena com os resultados do GpuProfiler: um grafico
+// com o tempo de GPU dos ultimos frames, empilhado por passe, e uma tabela com os
+// milissegundos de GPU e CPU e as draw calls de cada passe. O texto usa uma fonte
+// 3x5 embutida, entao o painel nao precisa de nenhuma textura. Tudo e montado em
+// coordenadas de tela (pixels, y para baixo) e desenhado com uma unica draw call.
+class ProfilerOverlay
+{
+public:
+	static const int HISTORY = 120;
+	ProfilerOverlay(const ShaderProgram& shader);
+	void update(const std::vector<GpuProfiler::Scope>& scopes);
+	void draw(int screenWidth, int screenHeight);
+	void deleteBuffers();
+private:
+	void addRect(float x, float y, float width, float height, const glm::vec4& color);
+	void addText(float x, float y, const std::string& text, const glm::vec4& color);
+	std::deque<std::vector<float>> m_history;
+	std::vector<GpuProfiler::Scope> m_latest;
+	std::vector<GLfloat> m_vertices;
+	GLuint VAO;
+	GLuint VBO;
+	GLuint shaderID;
+	GLint m_screenSizeLoc;
+};
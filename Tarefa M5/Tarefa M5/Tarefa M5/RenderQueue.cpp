@@ -0,0 +1,108 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+static const int DEPTH_BITS = 24;
+static const uint32_t DEPTH_MAX = (1u << DEPTH_BITS) - 1;
+static const uint64_t TRANSLUCENT_BIT = (uint64_t)1 << 63;
+
+void RenderQueue::clear()
+{
+	m_commands.clear();
+}
+
+void RenderQueue::push(Sprite* sprite)
+{
+	uint64_t key = makeKey(sprite->getRenderLayer(), sprite->isTranslucent(), sprite->getTextureID(), sprite->getTranslate().z);
+	m_commands.push_back({ key, sprite });
+}
+
+uint64_t RenderQueue::makeKey(int renderLayer, bool translucent, GLuint textureID, float depth)
+{
+	//z da projecao ortografica vai de -1 a 1; quanto maior o z, mais perto da camera
+	float normalized = std::min(std::max((depth + 1.0f) * 0.5f, 0.0f), 1.0f);
+	uint64_t depthBits = (uint64_t)(normalized * DEPTH_MAX);
+	uint64_t layer = (uint64_t)std::min(std::max(renderLayer, 0), 255);
+	uint64_t texture = textureID & 0xFFFFFF;
+
+	uint64_t key = 0;
+	if (translucent)
+	{
+		//de tras para frente: camada e z menores saem primeiro
+		key |= TRANSLUCENT_BIT;
+		key |= layer << 55;
+		key |= depthBits << 31;
+		key |= texture << 7;
+	}
+	else
+	{
+		//de frente para tras: camada e z maiores saem primeiro, para o teste de profundidade descartar mais
+		key |= (255 - layer) << 55;
+		key |= texture << 31;
+		key |= (DEPTH_MAX - depthBits) << 7;
+	}
+	return key;
+}
+
+// Indice do primeiro comando translucido (ou o total, se nao houver); so vale depois do sort
+int RenderQueue::getFirstTranslucent() const
+{
+	auto first = std::lower_bound(m_commands.begin(), m_commands.end(), TRANSLUCENT_BIT,
+		[](const DrawCommand& command, uint64_t key) { return command.key < key; });
+	return (int)(first - m_commands.begin());
+}
+
+// Radix sort LSD de 8 bits por passada. Os oito histogramas sao montados numa unica
+// leitura da fila, e as passadas em que todas as chaves tem o mesmo byte sao puladas
+// (o caso comum, ja que a camada quase nunca varia e os 7 bits de baixo sao zero).
+void RenderQueue::sort()
+{
+	size_t count = m_commands.size();
+	if (count < 2)
+	{
+		return;
+	}
+	m_scratch.resize(count);
+
+	uint32_t histograms[8][256] = {};
+	for (const DrawCommand& command : m_commands)
+	{
+		for (int pass = 0; pass < 8; pass++)
+		{
+			histograms[pass][(command.key >> (pass * 8)) & 0xFF]++;
+		}
+	}
+
+	DrawCommand* source = m_commands.data();
+	DrawCommand* destination = m_scratch.data();
+	for (int pass = 0; pass < 8; pass++)
+	{
+		uint32_t* histogram = histograms[pass];
+		int shift = pass * 8;
+		if (histogram[(source[0].key >> shift) & 0xFF] == count)
+		{
+			continue;
+		}
+		//prefix sum: posicao inicial de cada byte na saida
+		uint32_t offset = 0;
+		for (int digit = 0; digit < 256; digit++)
+		{
+			uint32_t digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+		for (size_t i = 0; i < count; i++)
+		{
+			destination[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+		}
+		std::swap(source, destination);
+	}
+	if (source != m_commands.data())
+	{
+		m_commands.swap(m_scratch);
+	}
+}
+
+const std::vector<DrawCommand>& RenderQueue::getCommands() const
+{
+	return m_commands;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+#include "Sprite.h"
+
+// Comando de desenho leve: a chave de ordenacao e o sprite que sera desenhado
+struct DrawCommand
+{
+	uint64_t key;
+	Sprite* sprite;
+};
+
+// Fila de desenho ordenada por chaves de 64 bits. O bit mais alto separa os dois
+// passes: todos os opacos saem antes de todos os translucidos.
+// Opacos (com teste de profundidade): camada invertida (8) | textura (24) |
+// profundidade de frente para tras (24), para trocar o minimo de estado e deixar o
+// teste de profundidade descartar o que fica escondido.
+// Translucidos (com blending): camada (8) | profundidade de tras para frente (24) |
+// textura (24).
+// Nao ha campo de shader: em todos os modos de desenho um unico programa fica ligado
+// durante o passe inteiro, entao ordenar por ele nao economiza nenhuma troca.
+// A ordenacao e estavel, entao comandos com a mesma chave saem na ordem em que foram
+// enviados.
+class RenderQueue
+{
+public:
+	void clear();
+	void push(Sprite* sprite);
+	void sort();
+	const std::vector<DrawCommand>& getCommands() const;
+	int getFirstTranslucent() const;
+	static uint64_t makeKey(int renderLayer, bool translucent, GLuint textureID, float depth);
+private:
+	std::vector<DrawCommand> m_commands;
+	std::vector<DrawCommand> m_scratch;
+};
@@ -0,0 +1,36 @@
+#include "Scene.h"
+#include <random>
+
+const SpriteImage images[] = {
+	{ "assets/samurai.png", 1, 1 },
+	{ "assets/hood_archer.png", 1, 1 },
+	{ "assets/monster0.png", 1, 1 },
+	{ "assets/monster1.png", 1, 1 },
+	{ "assets/monster2.png", 1, 1 },
+	{ "assets/Sword_Run_full.png", 8, 4 }
+};
+const int IMAGE_COUNT = sizeof(images) / sizeof(images[0]);
+
+// Cena inicial: os inimigos na camada 1 e o personagem controlado por cima, na camada 2.
+// Com worldSprites > 0, mais inimigos sao espalhados pelo mundo
+std::vector<SceneSprite> buildScene(int worldSprites)
+{
+	std::vector<SceneSprite> scene = {
+		{ 0, glm::vec3(100, 100, 0), glm::vec3(100, 100, 0), 1 },
+		{ 1, glm::vec3(300, 100, 0), glm::vec3(100, 100, 0), 1 },
+		{ 2, glm::vec3(200, 400, 0), glm::vec3(150, 150, 0), 1 },
+		{ 3, glm::vec3(600, 300, 0), glm::vec3(180, 180, 0), 1 },
+		{ 4, glm::vec3(600, 100, 0), glm::vec3(200, 200, 0), 1 },
+		{ 5, glm::vec3(400, 400, 0), glm::vec3(100, 100, 0), 2 }
+	};
+	std::mt19937 levelGen(1234);
+	std::uniform_real_distribution<float> distX(0.0f, WORLD_SIZE.x);
+	std::uniform_real_distribution<float> distY(0.0f, WORLD_SIZE.y);
+	for (int i = 0; i < worldSprites; i++)
+	{
+		float x = distX(levelGen);
+		float y = distY(levelGen);
+		scene.push_back({ 2 + i % 3, glm::vec3(x, y, 0), glm::vec3(100, 100, 0), 1 });
+	}
+	return scene;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+
+// Dimensoes da janela (pode ser alterado em tempo de execucao)
+const GLuint WIDTH = 800, HEIGHT = 600;
+
+// Imagens dos sprites. Todas vao para um atlas (ou para uma textura array), assim
+// trocar de sprite nao troca de textura. O layout da spritesheet entra junto para a
+// malha recortada pelo alfa cobrir todos os quadros
+struct SpriteImage
+{
+	const char* path;
+	int columns;
+	int rows;
+};
+extern const SpriteImage images[];
+extern const int IMAGE_COUNT;
+
+// Sprites da cena: imagem, posicao, escala e camada da RenderQueue. O mesmo layout
+// serve para os Sprites do OpenGL e para o SoftwareRenderer
+struct SceneSprite
+{
+	int image;
+	glm::vec3 translate;
+	glm::vec3 scale;
+	int renderLayer;
+};
+// Indice do personagem controlado pelo teclado
+const int PLAYER = 5;
+// Tamanho do mundo no modo --world-sprites
+const glm::vec2 WORLD_SIZE = glm::vec2(WIDTH, HEIGHT) * 20.0f;
+
+// Cena inicial: os inimigos na camada 1 e o personagem controlado por cima, na camada 2.
+// Com worldSprites > 0, mais inimigos sao espalhados pelo mundo
+std::vector<SceneSprite> buildScene(int worldSprites);
@@ -0,0 +1,94 @@
+#include "ShaderProgram.h"
+#include <iostream>
+#include <vector>
+
+ShaderProgram::ShaderProgram(GLuint programID)
+{
+	m_ID = programID;
+	reflect();
+}
+
+void ShaderProgram::use() const
+{
+	glUseProgram(m_ID);
+}
+
+GLuint ShaderProgram::getID() const
+{
+	return m_ID;
+}
+
+GLint ShaderProgram::getUniformLocation(const std::string& name) const
+{
+	auto found = m_uniformLocations.find(name);
+	if (found == m_uniformLocations.end())
+	{
+		//o compilador pode ter removido o uniform se ele nao e usado
+		return -1;
+	}
+	return found->second;
+}
+
+GLint ShaderProgram::getUniformBlockIndex(const std::string& name) const
+{
+	auto found = m_uniformBlocks.find(name);
+	if (found == m_uniformBlocks.end())
+	{
+		return -1;
+	}
+	return found->second;
+}
+
+void ShaderProgram::bindUniformBlock(const std::string& name, GLuint bindingPoint) const
+{
+	GLint blockIndex = getUniformBlockIndex(name);
+	if (blockIndex < 0)
+	{
+		std::cerr << "Uniform block nao encontrado: " << name << std::endl;
+		return;
+	}
+	glUniformBlockBinding(m_ID, blockIndex, bindingPoint);
+}
+
+void ShaderProgram::deleteProgram()
+{
+	glDeleteProgram(m_ID);
+}
+
+void ShaderProgram::reflect()
+{
+	GLint maxNameLength, count;
+	glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+	glGetProgramiv(m_ID, GL_ACTIVE_UNIFORMS, &count);
+	std::vector<GLchar> name(maxNameLength > 0 ? maxNameLength : 1);
+	for (GLint i = 0; i < count; i++)
+	{
+		GLsizei length;
+		GLint size;
+		GLenum type;
+		glGetActiveUniform(m_ID, i, (GLsizei)name.size(), &length, &size, &type, name.data());
+		GLint location = glGetUniformLocation(m_ID, name.data());
+		//uniforms dentro de blocks nao tem location
+		if (location < 0)
+		{
+			continue;
+		}
+		std::string uniformName(name.data(), length);
+		//arrays aparecem como "nome[0]"
+		if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+		{
+			uniformName.resize(uniformName.size() - 3);
+		}
+		m_uniformLocations[uniformName] = location;
+	}
+
+	glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxNameLength);
+	glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+	name.resize(maxNameLength > 0 ? maxNameLength : 1);
+	for (GLint i = 0; i < count; i++)
+	{
+		GLsizei length;
+		glGetActiveUniformBlockName(m_ID, i, (GLsizei)name.size(), &length, name.data());
+		m_uniformBlocks[std::string(name.data(), length)] = i;
+	}
+}
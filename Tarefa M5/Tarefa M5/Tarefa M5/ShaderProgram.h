@@ -0,0 +1,24 @@
+#pragma once
+#include <glad/glad.h>
+#include <string>
+#include <unordered_map>
+
+// Programa de shader ja linkado (por exemplo, o retorno do setupShader) com os
+// uniforms e uniform blocks ativos lidos uma unica vez. As locations devem ser
+// guardadas por quem usa o programa, fora do loop de desenho.
+class ShaderProgram
+{
+public:
+	ShaderProgram(GLuint programID);
+	void use() const;
+	GLuint getID() const;
+	GLint getUniformLocation(const std::string& name) const;
+	GLint getUniformBlockIndex(const std::string& name) const;
+	void bindUniformBlock(const std::string& name, GLuint bindingPoint) const;
+	void deleteProgram();
+private:
+	void reflect();
+	GLuint m_ID;
+	std::unordered_map<std::string, GLint> m_uniformLocations;
+	std::unordered_map<std::string, GLint> m_uniformBlocks;
+};
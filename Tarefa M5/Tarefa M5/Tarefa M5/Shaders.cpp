@@ -0,0 +1,281 @@
+#include "Shaders.h"
+#include <iostream>
+
+// Codigo fonte do Vertex Shader (em GLSL): ainda hardcoded
+const GLchar* vertexShaderSource = R"(#version 400
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 colors;
+layout (location = 2) in vec2 texture_mapping;
+
+out vec2 texture_coordinates;
+out vec3 color_values;
+flat out vec4 uv_rect;
+flat out int texture_layer;
+
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    float time;
+};
+uniform mat4 model;
+uniform vec2 scrollOffset;
+
+uniform ivec2 sheetSize;   
+uniform int frameIndex;
+uniform vec4 uvRect;
+uniform int layer;
+
+void main()
+{
+    int column = frameIndex % sheetSize.x;
+    int row    = frameIndex / sheetSize.x;
+    vec2 cellSize = vec2(1.0) / vec2(sheetSize);
+    vec2 frameOffset = vec2(column, row) * cellSize;
+    texture_coordinates = texture_mapping * cellSize + frameOffset + scrollOffset;
+    color_values = colors;
+    uv_rect = uvRect;
+    texture_layer = layer;
+    gl_Position = projection * model * vec4(position, 1.0);
+})";
+
+//Codigo fonte do Fragment Shader (em GLSL): ainda hardcoded
+const GLchar* fragmentShaderSource = R"(#version 400
+in vec2 texture_coordinates;
+in vec3 color_values;
+flat in vec4 uv_rect;
+out vec4 color;
+
+uniform sampler2D spriteTexture;
+uniform float alphaCutoff;
+
+void main()
+{
+    vec4 texColor;
+    if (uv_rect.zw == vec2(1.0))
+    {
+        texColor = texture(spriteTexture, texture_coordinates);
+    }
+    else
+    {
+        // Regiao de um atlas: a conta da spritesheet continua em [0,1] e e
+        // repetida (fract) dentro do sub-retangulo, no lugar do GL_REPEAT
+        vec2 gradX = dFdx(texture_coordinates) * uv_rect.zw;
+        vec2 gradY = dFdy(texture_coordinates) * uv_rect.zw;
+        texColor = textureGrad(spriteTexture, uv_rect.xy + fract(texture_coordinates) * uv_rect.zw, gradX, gradY);
+    }
+    // No passe opaco os pixels recortados sao descartados e nao escrevem profundidade
+    if (texColor.a < alphaCutoff)
+        discard;
+    color = texColor;
+}
+)";
+
+// Variante do Fragment Shader para o modo --texture-array: as imagens sao camadas
+// de uma GL_TEXTURE_2D_ARRAY e a camada vem do vertice/instancia
+const GLchar* arrayFragmentShaderSource = R"(#version 400
+in vec2 texture_coordinates;
+in vec3 color_values;
+flat in vec4 uv_rect;
+flat in int texture_layer;
+out vec4 color;
+
+uniform sampler2DArray spriteTexture;
+uniform float alphaCutoff;
+
+void main()
+{
+    vec4 texColor;
+    if (uv_rect.zw == vec2(1.0))
+    {
+        texColor = texture(spriteTexture, vec3(texture_coordinates, texture_layer));
+    }
+    else
+    {
+        // Regiao de um atlas: a conta da spritesheet continua em [0,1] e e
+        // repetida (fract) dentro do sub-retangulo, no lugar do GL_REPEAT
+        vec2 gradX = dFdx(texture_coordinates) * uv_rect.zw;
+        vec2 gradY = dFdy(texture_coordinates) * uv_rect.zw;
+        texColor = textureGrad(spriteTexture, vec3(uv_rect.xy + fract(texture_coordinates) * uv_rect.zw, texture_layer), gradX, gradY);
+    }
+    // No passe opaco os pixels recortados sao descartados e nao escrevem profundidade
+    if (texColor.a < alphaCutoff)
+        discard;
+    color = texColor;
+}
+)";
+
+// Vertex Shader do SpriteBatch: o model ja vem aplicado nas posicoes e os dados
+// da spritesheet chegam por vertice, mas a conta das coordenadas e a mesma
+const GLchar* batchVertexShaderSource = R"(#version 400
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 texture_mapping;
+layout (location = 2) in ivec2 sheetSize;
+layout (location = 3) in int frameIndex;
+layout (location = 4) in vec2 scrollOffset;
+layout (location = 5) in vec4 uvRect;
+layout (location = 6) in int layer;
+
+out vec2 texture_coordinates;
+out vec3 color_values;
+flat out vec4 uv_rect;
+flat out int texture_layer;
+
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    float time;
+};
+
+void main()
+{
+    int column = frameIndex % sheetSize.x;
+    int row    = frameIndex / sheetSize.x;
+    vec2 cellSize = vec2(1.0) / vec2(sheetSize);
+    vec2 frameOffset = vec2(column, row) * cellSize;
+    texture_coordinates = texture_mapping * cellSize + frameOffset + scrollOffset;
+    color_values = vec3(0.0);
+    uv_rect = uvRect;
+    texture_layer = layer;
+    gl_Position = projection * vec4(position, 1.0);
+})";
+
+// Vertex Shader do SpriteInstancer: translate, scale e os dados da spritesheet
+// chegam como atributos por instancia em vez de uniforms
+const GLchar* instancedVertexShaderSource = R"(#version 400
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec2 texture_mapping;
+layout (location = 3) in vec3 translate;
+layout (location = 4) in vec3 scale;
+layout (location = 5) in ivec2 sheetSize;
+layout (location = 6) in int frameIndex;
+layout (location = 7) in vec2 scrollOffset;
+layout (location = 8) in vec4 uvRect;
+layout (location = 9) in int layer;
+
+out vec2 texture_coordinates;
+out vec3 color_values;
+flat out vec4 uv_rect;
+flat out int texture_layer;
+
+layout (std140) uniform FrameData
+{
+    mat4 projection;
+    float time;
+};
+
+void main()
+{
+    int column = frameIndex % sheetSize.x;
+    int row    = frameIndex / sheetSize.x;
+    vec2 cellSize = vec2(1.0) / vec2(sheetSize);
+    vec2 frameOffset = vec2(column, row) * cellSize;
+    texture_coordinates = texture_mapping * cellSize + frameOffset + scrollOffset;
+    color_values = vec3(0.0);
+    uv_rect = uvRect;
+    texture_layer = layer;
+    gl_Position = projection * vec4(position * scale + translate, 1.0);
+})";
+
+// Shaders do fundo em camadas: um quad de tela cheia que compoe todas as camadas
+const GLchar* parallaxVertexShaderSource = R"(#version 400
+layout (location = 0) in vec2 position;
+
+out vec2 screen_coordinates;
+
+void main()
+{
+    screen_coordinates = position;
+    // Fica no fundo do depth buffer: so aparece onde nenhum sprite opaco foi desenhado
+    gl_Position = vec4(position * 2.0 - 1.0, 1.0, 1.0);
+})";
+
+const GLchar* parallaxFragmentShaderSource = R"(#version 400
+in vec2 screen_coordinates;
+out vec4 color;
+
+const int MAX_LAYERS = 4;
+uniform sampler2D layerTextures[MAX_LAYERS];
+// xy: repeticoes da camada na tela, zw: scrollOffset da camada
+uniform vec4 layerTransforms[MAX_LAYERS];
+uniform int layerCount;
+
+void main()
+{
+    // As camadas sao compostas de tras para frente aqui, sem um blending por camada
+    vec3 result = vec3(0.0);
+    for (int i = 0; i < layerCount; i++)
+    {
+        vec4 layerColor = texture(layerTextures[i], screen_coordinates * layerTransforms[i].xy + layerTransforms[i].zw);
+        result = mix(result, layerColor.rgb, layerColor.a);
+    }
+    color = vec4(result, 1.0);
+}
+)";
+
+// Shaders do painel do profiler: triangulos coloridos em coordenadas de tela (pixels, y para baixo)
+const GLchar* overlayVertexShaderSource = R"(#version 400
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec4 color;
+
+uniform vec2 screenSize;
+
+out vec4 vertex_color;
+
+void main()
+{
+    vertex_color = color;
+    gl_Position = vec4(position / screenSize * vec2(2.0, -2.0) + vec2(-1.0, 1.0), 0.0, 1.0);
+})";
+
+const GLchar* overlayFragmentShaderSource = R"(#version 400
+in vec4 vertex_color;
+out vec4 color;
+
+void main()
+{
+    color = vertex_color;
+}
+)";
+
+int setupShader(const GLchar* vertexSource, const GLchar* fragmentSource)
+{
+	// Vertex shader
+	GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(vertexShader, 1, &vertexSource, NULL);
+	glCompileShader(vertexShader);
+	// Checando erros de compilacao (exibicao via log no terminal)
+	GLint success;
+	GLchar infoLog[512];
+	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+	}
+	// Fragment shader
+	GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
+	glCompileShader(fragmentShader);
+	// Checando erros de compilacao (exibicao via log no terminal)
+	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+	}
+	// Linkando os shaders e criando o identificador do programa de shader
+	GLuint shaderProgram = glCreateProgram();
+	glAttachShader(shaderProgram, vertexShader);
+	glAttachShader(shaderProgram, fragmentShader);
+	glLinkProgram(shaderProgram);
+	// Checando por erros de linkagem
+	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+	if (!success) {
+		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+	}
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	return shaderProgram;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <glad/glad.h>
+
+// Codigo fonte dos shaders da Tarefa M5 (em GLSL), compartilhado com o Benchmark M5
+
+// Sprite desenhado sozinho (Sprite::Draw), com model e dados da spritesheet em uniforms
+extern const GLchar* vertexShaderSource;
+extern const GLchar* fragmentShaderSource;
+// Fragment shader do modo --texture-array
+extern const GLchar* arrayFragmentShaderSource;
+// SpriteBatch e SpriteInstancer
+extern const GLchar* batchVertexShaderSource;
+extern const GLchar* instancedVertexShaderSource;
+// ParallaxBackground
+extern const GLchar* parallaxVertexShaderSource;
+extern const GLchar* parallaxFragmentShaderSource;
+// ProfilerOverlay
+extern const GLchar* overlayVertexShaderSource;
+extern const GLchar* overlayFragmentShaderSource;
+
+// Compila e linka o programa, mostrando os erros no terminal
+int setupShader(const GLchar* vertexSource, const GLchar* fragmentSource);
@@ -0,0 +1,362 @@
+#include "SoftwareRenderer.h"
+#include "stb/stb_image.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTWARE_RENDERER_SSE
+#endif
+
+// Cores em float RGBA na escala 0..255; com SSE cada cor ocupa um registrador
+#ifdef SOFTWARE_RENDERER_SSE
+typedef __m128 Color;
+
+static inline Color loadTexel(const unsigned char* texel)
+{
+	__m128i value = _mm_cvtsi32_si128(*(const int*)texel);
+	value = _mm_unpacklo_epi8(value, _mm_setzero_si128());
+	value = _mm_unpacklo_epi16(value, _mm_setzero_si128());
+	return _mm_cvtepi32_ps(value);
+}
+
+static inline Color loadColor(const float* color)
+{
+	return _mm_loadu_ps(color);
+}
+
+static inline void storeColor(float* color, Color value)
+{
+	_mm_storeu_ps(color, value);
+}
+
+static inline Color makeColor(float r, float g, float b, float a)
+{
+	return _mm_setr_ps(r, g, b, a);
+}
+
+static inline Color lerp(Color a, Color b, float t)
+{
+	return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t)));
+}
+
+static inline float alphaOf(Color color)
+{
+	return _mm_cvtss_f32(_mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+// GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA
+static inline Color blend(Color source, Color destination)
+{
+	__m128 alpha = _mm_mul_ps(_mm_shuffle_ps(source, source, _MM_SHUFFLE(3, 3, 3, 3)), _mm_set1_ps(1.0f / 255.0f));
+	return _mm_add_ps(destination, _mm_mul_ps(_mm_sub_ps(source, destination), alpha));
+}
+
+static inline void storePixel(unsigned char* pixel, Color color)
+{
+	__m128i value = _mm_cvtps_epi32(color);
+	value = _mm_packs_epi32(value, value);
+	value = _mm_packus_epi16(value, value);
+	*(int*)pixel = _mm_cvtsi128_si32(value);
+}
+#else
+typedef glm::vec4 Color;
+
+static inline Color loadTexel(const unsigned char* texel)
+{
+	return Color(texel[0], texel[1], texel[2], texel[3]);
+}
+
+static inline Color loadColor(const float* color)
+{
+	return Color(color[0], color[1], color[2], color[3]);
+}
+
+static inline void storeColor(float* color, Color value)
+{
+	color[0] = value.r;
+	color[1] = value.g;
+	color[2] = value.b;
+	color[3] = value.a;
+}
+
+static inline Color makeColor(float r, float g, float b, float a)
+{
+	return Color(r, g, b, a);
+}
+
+static inline Color lerp(Color a, Color b, float t)
+{
+	return a + (b - a) * t;
+}
+
+static inline float alphaOf(Color color)
+{
+	return color.a;
+}
+
+static inline Color blend(Color source, Color destination)
+{
+	return destination + (source - destination) * (source.a / 255.0f);
+}
+
+static inline void storePixel(unsigned char* pixel, Color color)
+{
+	for (int channel = 0; channel < 4; channel++)
+	{
+		pixel[channel] = (unsigned char)std::min(std::max(color[channel] + 0.5f, 0.0f), 255.0f);
+	}
+}
+#endif
+
+static inline int wrap(int value, int size)
+{
+	int result = value % size;
+	return result < 0 ? result + size : result;
+}
+
+// Filtro linear com GL_REPEAT, como os samplers do OpenGL
+template <typename TextureType>
+static Color sampleLinear(const TextureType& texture, glm::vec2 uv)
+{
+	float x = uv.x * texture.width - 0.5f;
+	float y = uv.y * texture.height - 0.5f;
+	float floorX = std::floor(x);
+	float floorY = std::floor(y);
+	float fractionX = x - floorX;
+	float fractionY = y - floorY;
+	int x0 = wrap((int)floorX, texture.width);
+	int y0 = wrap((int)floorY, texture.height);
+	int x1 = x0 + 1 == texture.width ? 0 : x0 + 1;
+	int y1 = y0 + 1 == texture.height ? 0 : y0 + 1;
+	const unsigned char* row0 = &texture.pixels[y0 * texture.width * 4];
+	const unsigned char* row1 = &texture.pixels[y1 * texture.width * 4];
+	Color bottom = lerp(loadTexel(row0 + x0 * 4), loadTexel(row0 + x1 * 4), fractionX);
+	Color top = lerp(loadTexel(row1 + x0 * 4), loadTexel(row1 + x1 * 4), fractionX);
+	return lerp(bottom, top, fractionY);
+}
+
+SoftwareRenderer::SoftwareRenderer(int width, int height, int threadCount)
+{
+	m_width = width;
+	m_height = height;
+	m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+	m_threadCount = threadCount > 0 ? threadCount : std::max(1, (int)std::thread::hardware_concurrency());
+	m_bins.resize(m_tilesX * m_tilesY);
+	m_pixels.assign(width * height * 4, 0);
+}
+
+int SoftwareRenderer::addTexture(const char* path)
+{
+	Texture texture;
+	int numChannels;
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* data = stbi_load(path, &texture.width, &texture.height, &numChannels, STBI_rgb_alpha);
+	if (data)
+	{
+		texture.pixels.assign(data, data + texture.width * texture.height * 4);
+		texture.alphaMode = classifyAlpha(data, texture.width * texture.height);
+	}
+	else
+	{
+		std::cerr << "Erro ao carregar textura: " << path << std::endl;
+		texture.width = 0;
+		texture.height = 0;
+	}
+	stbi_image_free(data);
+	m_textures.push_back(texture);
+	return (int)m_textures.size() - 1;
+}
+
+// Mesma conta do ParallaxBackground: scrollFactor 1 anda junto com o mundo e
+// tileSize e o tamanho de uma repeticao da imagem em coordenadas de mundo
+void SoftwareRenderer::addBackgroundLayer(int texture, float scrollFactor, glm::vec2 tileSize)
+{
+	m_layers.push_back({ texture, scrollFactor, tileSize });
+}
+
+void SoftwareRenderer::begin()
+{
+	m_sprites.clear();
+}
+
+// Os sprites sao desenhados na ordem de envio (algoritmo do pintor)
+void SoftwareRenderer::submit(const SoftwareSprite& sprite)
+{
+	m_sprites.push_back(sprite);
+}
+
+void SoftwareRenderer::end(const Camera2D& camera)
+{
+	//projecao ortografica da camera direto para pixels
+	glm::vec2 cameraPosition = camera.getPosition();
+	glm::vec2 pixelsPerUnit = glm::vec2(m_width, m_height) / camera.getSize();
+
+	m_quads.clear();
+	for (std::vector<int>& bin : m_bins)
+	{
+		bin.clear();
+	}
+	for (const SoftwareSprite& sprite : m_sprites)
+	{
+		if (sprite.texture < 0 || m_textures[sprite.texture].pixels.empty())
+		{
+			continue;
+		}
+		Quad quad;
+		glm::vec2 halfScale = glm::vec2(sprite.scale) * 0.5f;
+		quad.corner0 = (glm::vec2(sprite.translate) - halfScale - cameraPosition) * pixelsPerUnit;
+		quad.corner1 = (glm::vec2(sprite.translate) + halfScale - cameraPosition) * pixelsPerUnit;
+		quad.cellSize = glm::vec2(1.0f) / glm::vec2(sprite.sheetSize);
+		int column = sprite.frameIndex % sprite.sheetSize.x;
+		int row = sprite.frameIndex / sprite.sheetSize.x;
+		quad.offset = glm::vec2(column, row) * quad.cellSize + sprite.scrollOffset;
+		quad.texture = sprite.texture;
+
+		glm::vec2 minCorner = glm::min(quad.corner0, quad.corner1);
+		glm::vec2 maxCorner = glm::max(quad.corner0, quad.corner1);
+		if (maxCorner.x <= 0.0f || maxCorner.y <= 0.0f || minCorner.x >= m_width || minCorner.y >= m_height || minCorner.x == maxCorner.x || minCorner.y == maxCorner.y)
+		{
+			continue;
+		}
+		int firstTileX = std::max(0, (int)(minCorner.x / TILE_SIZE));
+		int firstTileY = std::max(0, (int)(minCorner.y / TILE_SIZE));
+		int lastTileX = std::min(m_tilesX - 1, (int)(maxCorner.x / TILE_SIZE));
+		int lastTileY = std::min(m_tilesY - 1, (int)(maxCorner.y / TILE_SIZE));
+		int quadIndex = (int)m_quads.size();
+		m_quads.push_back(quad);
+		for (int tileY = firstTileY; tileY <= lastTileY; tileY++)
+		{
+			for (int tileX = firstTileX; tileX <= lastTileX; tileX++)
+			{
+				m_bins[tileY * m_tilesX + tileX].push_back(quadIndex);
+			}
+		}
+	}
+
+	//xy: quantas repeticoes da camada cabem na vista, zw: scrollOffset da camada
+	std::vector<glm::vec4> layerTransforms;
+	for (const BackgroundLayer& layer : m_layers)
+	{
+		layerTransforms.push_back(glm::vec4(camera.getSize() / layer.tileSize, cameraPosition * layer.scrollFactor / layer.tileSize));
+	}
+
+	//cada thread pega o proximo tile livre; os tiles nao se sobrepoem, entao nao ha trava
+	std::atomic<int> nextTile(0);
+	int tileCount = m_tilesX * m_tilesY;
+	auto worker = [&]() {
+		std::vector<float> buffer(TILE_SIZE * TILE_SIZE * 4);
+		for (int tile = nextTile++; tile < tileCount; tile = nextTile++)
+		{
+			renderTile(tile, layerTransforms, buffer);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int i = 1; i < m_threadCount; i++)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void SoftwareRenderer::renderTile(int tile, const std::vector<glm::vec4>& layerTransforms, std::vector<float>& buffer)
+{
+	int tileX = (tile % m_tilesX) * TILE_SIZE;
+	int tileY = (tile / m_tilesX) * TILE_SIZE;
+	int tileWidth = std::min(TILE_SIZE, m_width - tileX);
+	int tileHeight = std::min(TILE_SIZE, m_height - tileY);
+
+	//fundo: as camadas sao compostas de tras para frente, como no shader do fundo
+	for (int y = 0; y < tileHeight; y++)
+	{
+		for (int x = 0; x < tileWidth; x++)
+		{
+			glm::vec2 screen = glm::vec2(tileX + x + 0.5f, tileY + y + 0.5f) / glm::vec2(m_width, m_height);
+			Color color = makeColor(0.0f, 0.0f, 0.0f, 255.0f);
+			for (int i = 0; i < (int)m_layers.size(); i++)
+			{
+				const Texture& texture = m_textures[m_layers[i].texture];
+				if (texture.pixels.empty())
+				{
+					continue;
+				}
+				const glm::vec4& transform = layerTransforms[i];
+				color = blend(sampleLinear(texture, screen * glm::vec2(transform) + glm::vec2(transform.z, transform.w)), color);
+			}
+			storeColor(&buffer[(y * TILE_SIZE + x) * 4], color);
+		}
+	}
+
+	for (int quadIndex : m_bins[tile])
+	{
+		const Quad& quad = m_quads[quadIndex];
+		const Texture& texture = m_textures[quad.texture];
+		glm::vec2 minCorner = glm::min(quad.corner0, quad.corner1);
+		glm::vec2 maxCorner = glm::max(quad.corner0, quad.corner1);
+		//pixels cujo centro cai dentro do quad
+		int firstX = std::max(tileX, (int)std::ceil(minCorner.x - 0.5f));
+		int firstY = std::max(tileY, (int)std::ceil(minCorner.y - 0.5f));
+		int lastX = std::min(tileX + tileWidth, (int)std::ceil(maxCorner.x - 0.5f));
+		int lastY = std::min(tileY + tileHeight, (int)std::ceil(maxCorner.y - 0.5f));
+		glm::vec2 inverseSize = 1.0f / (quad.corner1 - quad.corner0);
+		//opacos e recortados usam o discard do passe opaco; translucidos usam blending
+		bool cutout = texture.alphaMode != ALPHA_TRANSLUCENT;
+		for (int y = firstY; y < lastY; y++)
+		{
+			float* target = &buffer[((y - tileY) * TILE_SIZE + firstX - tileX) * 4];
+			for (int x = firstX; x < lastX; x++, target += 4)
+			{
+				glm::vec2 mapping = (glm::vec2(x + 0.5f, y + 0.5f) - quad.corner0) * inverseSize;
+				Color source = sampleLinear(texture, mapping * quad.cellSize + quad.offset);
+				if (cutout)
+				{
+					if (alphaOf(source) >= 127.5f)
+					{
+						storeColor(target, source);
+					}
+				}
+				else
+				{
+					storeColor(target, blend(source, loadColor(target)));
+				}
+			}
+		}
+	}
+
+	for (int y = 0; y < tileHeight; y++)
+	{
+		for (int x = 0; x < tileWidth; x++)
+		{
+			storePixel(&m_pixels[((tileY + y) * m_width + tileX + x) * 4], loadColor(&buffer[(y * TILE_SIZE + x) * 4]));
+		}
+	}
+}
+
+// Pixels RGB da imagem, da linha de cima para a de baixo (a ordem do PPM)
+void SoftwareRenderer::readPixels(std::vector<unsigned char>& rgb) const
+{
+	rgb.resize(m_width * m_height * 3);
+	for (int y = 0; y < m_height; y++)
+	{
+		const unsigned char* source = &m_pixels[(m_height - 1 - y) * m_width * 4];
+		unsigned char* destination = &rgb[y * m_width * 3];
+		for (int x = 0; x < m_width; x++)
+		{
+			destination[x * 3 + 0] = source[x * 4 + 0];
+			destination[x * 3 + 1] = source[x * 4 + 1];
+			destination[x * 3 + 2] = source[x * 4 + 2];
+		}
+	}
+}
+
+int SoftwareRenderer::getThreadCount() const
+{
+	return m_threadCount;
+}
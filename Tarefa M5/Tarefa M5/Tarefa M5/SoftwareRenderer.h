@@ -0,0 +1,75 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include "Camera2D.h"
+#include "TextureAtlas.h"
+
+// Dados de um sprite para o SoftwareRenderer: os mesmos atributos por instancia
+// que o shader do SpriteInstancer recebe
+struct SoftwareSprite
+{
+	int texture;
+	glm::vec3 translate;
+	glm::vec3 scale;
+	glm::ivec2 sheetSize = glm::ivec2(1);
+	int frameIndex = 0;
+	glm::vec2 scrollOffset = glm::vec2(0.0f);
+};
+
+// Desenha a cena de sprites na CPU, sem nenhuma chamada OpenGL (miniaturas e
+// previews no servidor). Reproduz os shaders do Tarefa M5.cpp: projecao ortografica
+// da Camera2D, conta de UV da spritesheet com GL_REPEAT, filtro linear, recorte de
+// alfa dos sprites opacos/recortados e blending dos translucidos, com o fundo em
+// camadas por baixo. Os quads sao separados em tiles de tela e os tiles sao
+// desenhados em paralelo, cada thread com o seu buffer; a amostragem e o blending
+// usam SSE quando disponivel.
+class SoftwareRenderer
+{
+public:
+	static const int TILE_SIZE = 64;
+	SoftwareRenderer(int width, int height, int threadCount = 0);
+	int addTexture(const char* path);
+	void addBackgroundLayer(int texture, float scrollFactor, glm::vec2 tileSize);
+	void begin();
+	void submit(const SoftwareSprite& sprite);
+	void end(const Camera2D& camera);
+	void readPixels(std::vector<unsigned char>& rgb) const;
+	int getThreadCount() const;
+private:
+	struct Texture
+	{
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels;
+		AlphaMode alphaMode = ALPHA_TRANSLUCENT;
+	};
+	struct BackgroundLayer
+	{
+		int texture;
+		float scrollFactor;
+		glm::vec2 tileSize;
+	};
+	// Quad ja em coordenadas de tela: corner0 e o canto com texture_mapping (0,0)
+	// e corner1 o canto com (1,1); o resto da conta de UV e cellSize e offset
+	struct Quad
+	{
+		glm::vec2 corner0;
+		glm::vec2 corner1;
+		glm::vec2 cellSize;
+		glm::vec2 offset;
+		int texture;
+	};
+	void renderTile(int tile, const std::vector<glm::vec4>& layerTransforms, std::vector<float>& buffer);
+	int m_width;
+	int m_height;
+	int m_tilesX;
+	int m_tilesY;
+	int m_threadCount;
+	std::vector<Texture> m_textures;
+	std::vector<BackgroundLayer> m_layers;
+	std::vector<SoftwareSprite> m_sprites;
+	std::vector<Quad> m_quads;
+	std::vector<std::vector<int>> m_bins;
+	//RGBA8 com a linha de baixo primeiro, como o glReadPixels
+	std::vector<unsigned char> m_pixels;
+};
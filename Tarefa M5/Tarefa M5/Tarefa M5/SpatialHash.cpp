@@ -0,0 +1,170 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPATIAL_HASH_SSE
+#endif
+
+SpatialHash::SpatialHash(float cellSize)
+{
+	m_cellSize = cellSize;
+}
+
+// Devolve o id do sprite no hash, usado depois em move()
+int SpatialHash::insert(Sprite* sprite)
+{
+	Entry entry;
+	entry.sprite = sprite;
+	m_entries.push_back(entry);
+	int id = (int)m_entries.size() - 1;
+	addToCells(id);
+	return id;
+}
+
+// Atualiza um sprite que mudou de posicao ou de tamanho
+void SpatialHash::move(int id)
+{
+	Entry& entry = m_entries[id];
+	glm::vec4 bounds = getBounds(*entry.sprite);
+	if (bounds == entry.bounds)
+	{
+		return;
+	}
+	removeFromCells(id);
+	addToCells(id);
+}
+
+// Sprites que tocam a vista (minX, minY, maxX, maxY), na ordem em que foram inseridos
+void SpatialHash::query(const glm::vec4& view, std::vector<Sprite*>& visible)
+{
+	m_queryStamp++;
+	m_visibleIDs.clear();
+	glm::ivec4 range = getCellRange(view);
+#ifdef SPATIAL_HASH_SSE
+	__m128 viewMinX = _mm_set1_ps(view.x);
+	__m128 viewMinY = _mm_set1_ps(view.y);
+	__m128 viewMaxX = _mm_set1_ps(view.z);
+	__m128 viewMaxY = _mm_set1_ps(view.w);
+#endif
+	for (int cellY = range.y; cellY <= range.w; cellY++)
+	{
+		for (int cellX = range.x; cellX <= range.z; cellX++)
+		{
+			auto found = m_cells.find(getKey(cellX, cellY));
+			if (found == m_cells.end())
+			{
+				continue;
+			}
+			const Cell& cell = found->second;
+			int count = (int)cell.ids.size();
+			int i = 0;
+#ifdef SPATIAL_HASH_SSE
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 overlap = _mm_and_ps(
+					_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&cell.minX[i]), viewMaxX), _mm_cmpge_ps(_mm_loadu_ps(&cell.maxX[i]), viewMinX)),
+					_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&cell.minY[i]), viewMaxY), _mm_cmpge_ps(_mm_loadu_ps(&cell.maxY[i]), viewMinY)));
+				int mask = _mm_movemask_ps(overlap);
+				for (int lane = 0; lane < 4; lane++)
+				{
+					Entry& entry = m_entries[cell.ids[i + lane]];
+					if ((mask & (1 << lane)) && entry.lastQuery != m_queryStamp)
+					{
+						entry.lastQuery = m_queryStamp;
+						m_visibleIDs.push_back(cell.ids[i + lane]);
+					}
+				}
+			}
+#endif
+			for (; i < count; i++)
+			{
+				Entry& entry = m_entries[cell.ids[i]];
+				if (cell.minX[i] <= view.z && cell.maxX[i] >= view.x && cell.minY[i] <= view.w && cell.maxY[i] >= view.y
+					&& entry.lastQuery != m_queryStamp)
+				{
+					entry.lastQuery = m_queryStamp;
+					m_visibleIDs.push_back(cell.ids[i]);
+				}
+			}
+		}
+	}
+	//volta para a ordem de insercao, que e a ordem de desenho dentro de uma camada
+	std::sort(m_visibleIDs.begin(), m_visibleIDs.end());
+	visible.clear();
+	for (int id : m_visibleIDs)
+	{
+		visible.push_back(m_entries[id].sprite);
+	}
+}
+
+int SpatialHash::getCount() const
+{
+	return (int)m_entries.size();
+}
+
+// O quad do sprite e centrado no translate e tem o tamanho do scale
+glm::vec4 SpatialHash::getBounds(const Sprite& sprite)
+{
+	glm::vec2 center = glm::vec2(sprite.getTranslate());
+	glm::vec2 halfSize = glm::abs(glm::vec2(sprite.getScale())) * 0.5f;
+	return glm::vec4(center - halfSize, center + halfSize);
+}
+
+glm::ivec4 SpatialHash::getCellRange(const glm::vec4& bounds) const
+{
+	return glm::ivec4(
+		(int)std::floor(bounds.x / m_cellSize),
+		(int)std::floor(bounds.y / m_cellSize),
+		(int)std::floor(bounds.z / m_cellSize),
+		(int)std::floor(bounds.w / m_cellSize));
+}
+
+long long SpatialHash::getKey(int cellX, int cellY)
+{
+	return ((long long)cellX << 32) | (unsigned int)cellY;
+}
+
+void SpatialHash::addToCells(int id)
+{
+	Entry& entry = m_entries[id];
+	entry.bounds = getBounds(*entry.sprite);
+	entry.cells = getCellRange(entry.bounds);
+	for (int cellY = entry.cells.y; cellY <= entry.cells.w; cellY++)
+	{
+		for (int cellX = entry.cells.x; cellX <= entry.cells.z; cellX++)
+		{
+			Cell& cell = m_cells[getKey(cellX, cellY)];
+			cell.minX.push_back(entry.bounds.x);
+			cell.minY.push_back(entry.bounds.y);
+			cell.maxX.push_back(entry.bounds.z);
+			cell.maxY.push_back(entry.bounds.w);
+			cell.ids.push_back(id);
+		}
+	}
+}
+
+// Tira o sprite das celulas antigas trocando-o pelo ultimo de cada uma
+void SpatialHash::removeFromCells(int id)
+{
+	const Entry& entry = m_entries[id];
+	for (int cellY = entry.cells.y; cellY <= entry.cells.w; cellY++)
+	{
+		for (int cellX = entry.cells.x; cellX <= entry.cells.z; cellX++)
+		{
+			Cell& cell = m_cells[getKey(cellX, cellY)];
+			int index = (int)(std::find(cell.ids.begin(), cell.ids.end(), id) - cell.ids.begin());
+			int last = (int)cell.ids.size() - 1;
+			cell.minX[index] = cell.minX[last];
+			cell.minY[index] = cell.minY[last];
+			cell.maxX[index] = cell.maxX[last];
+			cell.maxY[index] = cell.maxY[last];
+			cell.ids[index] = cell.ids[last];
+			cell.minX.pop_back();
+			cell.minY.pop_back();
+			cell.maxX.pop_back();
+			cell.maxY.pop_back();
+			cell.ids.pop_back();
+		}
+	}
+}
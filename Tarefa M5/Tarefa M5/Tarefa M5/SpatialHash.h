@@ -0,0 +1,45 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include <unordered_map>
+#include "Sprite.h"
+
+// Hash espacial sobre os retangulos dos sprites, para desenhar so o que esta na
+// vista. Cada celula guarda os limites dos seus sprites em arrays separados
+// (minX, minY, maxX, maxY), e o teste contra a vista e feito 4 sprites por vez
+// com SSE. Um sprite maior que uma celula entra em todas as celulas que toca.
+class SpatialHash
+{
+public:
+	SpatialHash(float cellSize = 256.0f);
+	int insert(Sprite* sprite);
+	void move(int id);
+	void query(const glm::vec4& view, std::vector<Sprite*>& visible);
+	int getCount() const;
+private:
+	struct Cell
+	{
+		std::vector<float> minX;
+		std::vector<float> minY;
+		std::vector<float> maxX;
+		std::vector<float> maxY;
+		std::vector<int> ids;
+	};
+	struct Entry
+	{
+		Sprite* sprite;
+		glm::vec4 bounds;
+		glm::ivec4 cells;
+		unsigned int lastQuery = 0;
+	};
+	static glm::vec4 getBounds(const Sprite& sprite);
+	glm::ivec4 getCellRange(const glm::vec4& bounds) const;
+	static long long getKey(int cellX, int cellY);
+	void addToCells(int id);
+	void removeFromCells(int id);
+	float m_cellSize;
+	std::unordered_map<long long, Cell> m_cells;
+	std::vector<Entry> m_entries;
+	std::vector<int> m_visibleIDs;
+	unsigned int m_queryStamp = 0;
+};
@@ -4,7 +4,7 @@
 #include "dependencies/glm/gtc/type_ptr.hpp"
 #include <iostream>
 
-Sprite::Sprite(const char* path, GLuint shaderID)
+Sprite::Sprite(const char* path, const ShaderProgram& shader)
 {
 	//Gerar a textura
 	glGenTextures(1, &m_TextureID);
@@ -22,6 +22,7 @@ Sprite::Sprite(const char* path, GLuint shaderID)
 		GLenum format = numChannels == 4 ? GL_RGBA : GL_RGB;
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 		glGenerateMipmap(GL_TEXTURE_2D);
+		m_alphaMode = classifyAlpha(data, width * height);
 	}
 	else
 	{
@@ -29,54 +30,52 @@ Sprite::Sprite(const char* path, GLuint shaderID)
 	}
 	stbi_image_free(data);
 
-	//Gerar a geometria
-	GLuint VBO;
-	float vertices[] = {
-		//posies			//cores				//coordenadas de textura
-		0.5, 0.5, 0.0,		0.0, 0.0, 0.0,		1.0, 1.0,
-		-0.5, -0.5, 0.0,	0.0, 0.0, 0.0,		0.0, 0.0,
-		0.5, -0.5, 0.0,		0.0, 0.0, 0.0,		1.0, 0.0,
-		-0.5, 0.5, 0.0,		0.0, 0.0, 0.0,		0.0, 1.0
-	};
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-	glGenBuffers(1, &VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-	//atributo de posio
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-	//atributo de cor
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
-	//atributo de coordenada de textura
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
-	unsigned int indices[] = {
-		0, 1, 2,//primeiro triangulo
-		0, 3, 1 //segundo triangulo
-	};
-	GLuint EBO;
-	glGenBuffers(1, &EBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-	this->shaderID = shaderID;
+	//A geometria  o quad unitrio compartilhado por todos os sprites
+	m_meshID = MeshRegistry::acquire(MeshRegistry::UNIT_QUAD);
+	setupShaderLocations(shader);
+}
+
+// Sprite que usa um sub-retngulo de um TextureAtlas em vez de uma textura prpria
+Sprite::Sprite(const AtlasRegion& region, const ShaderProgram& shader)
+{
+	m_TextureID = region.textureID;
+	m_uvRect = region.uvRect;
+	m_textureTarget = region.target;
+	m_layer = region.layer;
+	m_alphaMode = region.alphaMode;
+	//Com o polgono recortado pelo alfa, os texels transparentes nem so rasterizados
+	m_meshID = MeshRegistry::acquire(region.meshName.empty() ? MeshRegistry::UNIT_QUAD : region.meshName);
+	setupShaderLocations(shader);
+}
+
+void Sprite::setupShaderLocations(const ShaderProgram& shader)
+{
+	shaderID = shader.getID();
+	m_modelLoc = shader.getUniformLocation("model");
+	m_sheetSizeLoc = shader.getUniformLocation("sheetSize");
+	m_frameIndexLoc = shader.getUniformLocation("frameIndex");
+	m_scrollOffsetLoc = shader.getUniformLocation("scrollOffset");
+	m_uvRectLoc = shader.getUniformLocation("uvRect");
+	m_layerLoc = shader.getUniformLocation("layer");
 }
 
 void Sprite::Draw()
 {
-	glBindTexture(GL_TEXTURE_2D, m_TextureID);
-	glBindVertexArray(VAO);
+	glBindTexture(m_textureTarget, m_TextureID);
+	const Mesh& mesh = MeshRegistry::getMesh(m_meshID);
+	glBindVertexArray(mesh.VAO);
 	glm::mat4 model = glm::mat4(1);
 	model = glm::translate(model, m_translate);
 	model = glm::scale(model, m_scale);
-	glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-	glUniform2i(glGetUniformLocation(shaderID, "sheetSize"), m_sheetCols, m_sheetRows);
-	glUniform1i(glGetUniformLocation(shaderID, "frameIndex"), m_frameIndex);
-	glUniform2f(glGetUniformLocation(shaderID, "scrollOffset"), m_scrollOffset.x, m_scrollOffset.y);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+	glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, value_ptr(model));
+	glUniform2i(m_sheetSizeLoc, m_sheetCols, m_sheetRows);
+	glUniform1i(m_frameIndexLoc, m_frameIndex);
+	glUniform2f(m_scrollOffsetLoc, m_scrollOffset.x, m_scrollOffset.y);
+	glUniform4f(m_uvRectLoc, m_uvRect.x, m_uvRect.y, m_uvRect.z, m_uvRect.w);
+	glUniform1i(m_layerLoc, m_layer);
+	glDrawElements(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0);
 	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindTexture(m_textureTarget, 0);
 }
 
 void Sprite::setScale(glm::vec3 scale)
@@ -84,20 +83,16 @@ void Sprite::setScale(glm::vec3 scale)
 	m_scale = scale;
 }
 
-void Sprite::setTranslate(glm::vec3 translate)
-{
-	m_translate = translate;
-}
-
 void Sprite::deleteVertexArray()
 {
-	glDeleteVertexArrays(1, &VAO);
+	MeshRegistry::release(m_meshID);
 }
 
-void Sprite::setSpriteSheet(int cols, int rows)
+void Sprite::setMesh(const char* name)
 {
-	m_sheetCols = cols;
-	m_sheetRows = rows;
+	int meshID = MeshRegistry::acquire(name);
+	MeshRegistry::release(m_meshID);
+	m_meshID = meshID;
 }
 
 void Sprite::setScrollOffset(glm::vec2 offset)
@@ -105,51 +100,64 @@ void Sprite::setScrollOffset(glm::vec2 offset)
 	m_scrollOffset = offset;
 }
 
-void Sprite::update(float deltaTime)
+// Camada de desenho usada pela RenderQueue (camadas maiores ficam por cima)
+void Sprite::setRenderLayer(int renderLayer)
 {
-	
+	m_renderLayer = renderLayer;
 }
 
-void Sprite::setVelocity(const glm::vec3& velocity)
+glm::vec3 Sprite::getScale() const
 {
-	m_velocity = velocity;
+	return m_scale;
 }
 
-glm::vec3 Sprite::getVelocity() const
+GLuint Sprite::getTextureID() const
 {
-	return m_velocity;
+	return m_TextureID;
 }
 
-bool Sprite::updateAnimationFromVelocity()
+GLuint Sprite::getShaderID() const
 {
-	if (glm::length(m_velocity) < 0.01f) 
-	{
-		m_frameIndex = 24;
-		return true;
-	}
+	return shaderID;
+}
 
-	if (m_velocity.x > 0)
-	{
-		m_animationRow = 1; // direita
-		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
-		return false;
-	}
-	else if (m_velocity.x < 0)
-	{
-		m_animationRow = 2; // esquerda
-		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
-		return false;
-	}
-	else if(m_velocity.y > 0)
-	{
-		m_animationRow = 0; // cima
-		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
-		return false;
-	}
-	else if (m_velocity.y < 0)
-	{
-		m_animationRow = 3; // baixo
-		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
-		return false;
-	}
+glm::vec2 Sprite::getScrollOffset() const
+{
+	return m_scrollOffset;
+}
+
+glm::vec4 Sprite::getUVRect() const
+{
+	return m_uvRect;
+}
+
+GLenum Sprite::getTextureTarget() const
+{
+	return m_textureTarget;
+}
+
+int Sprite::getLayer() const
+{
+	return m_layer;
+}
+
+int Sprite::getRenderLayer() const
+{
+	return m_renderLayer;
+}
+
+int Sprite::getMeshID() const
+{
+	return m_meshID;
+}
+
+AlphaMode Sprite::getAlphaMode() const
+{
+	return m_alphaMode;
+}
+
+// Sprites opacos e recortados vo para o passe opaco, com teste de profundidade
+bool Sprite::isTranslucent() const
+{
+	return m_alphaMode == ALPHA_TRANSLUCENT;
 }
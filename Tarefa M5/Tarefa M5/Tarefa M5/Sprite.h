@@ -1,36 +1,55 @@
 #pragma once
 #include <glad/glad.h>
 #include "dependencies/glm/glm.hpp"
+#include "MeshRegistry.h"
+#include "ShaderProgram.h"
+#include "TextureAtlas.h"
+#include "SpriteState.h"
 
-class Sprite
+class Sprite : public SpriteState
 {
 public:
-	Sprite(const char* path, GLuint shaderID);
+	Sprite(const char* path, const ShaderProgram& shader);
+	Sprite(const AtlasRegion& region, const ShaderProgram& shader);
+	virtual ~Sprite() {}
 	void Draw();
 	void setScale(glm::vec3 scale);
-	void setTranslate(glm::vec3 translate);
 	void deleteVertexArray();
-	void setSpriteSheet(int cols, int rows);
+	void setMesh(const char* name);
 	void setScrollOffset(glm::vec2 offset);
-	virtual void update(float deltaTime);
-	void setVelocity(const glm::vec3& velocity);
-	glm::vec3 getVelocity() const;
+	void setRenderLayer(int renderLayer);
+	glm::vec3 getScale() const;
+	GLuint getTextureID() const;
+	GLuint getShaderID() const;
+	glm::vec2 getScrollOffset() const;
+	glm::vec4 getUVRect() const;
+	GLenum getTextureTarget() const;
+	int getLayer() const;
+	int getRenderLayer() const;
+	int getMeshID() const;
+	AlphaMode getAlphaMode() const;
+	bool isTranslucent() const;
 protected:
-	glm::vec3 m_translate;
-	int m_sheetCols = 1;
-	int m_sheetRows = 1;
-	int m_frameIndex = 0;
-	int m_animationRow = 0;
-	int m_currentFrame = 0;
+	// Sem textura, malha nem shader, so com o SpriteState: definido aqui para quem
+	// roda update() sem OpenGL nao precisar linkar o Sprite.cpp
+	Sprite() {}
 	glm::vec2 m_scrollOffset = glm::vec2(0.0f);
-	float m_animTimer = 0.0f;
-	float m_frameDuration = 0.1f;
-	glm::vec3 m_velocity = glm::vec3(0.0f);
-	bool updateAnimationFromVelocity();
 private:
-	GLuint m_TextureID;
-	GLuint VAO;
-	glm::vec3 m_scale;
-	GLuint shaderID;
+	GLuint m_TextureID = 0;
+	glm::vec4 m_uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	GLenum m_textureTarget = GL_TEXTURE_2D;
+	int m_layer = 0;
+	int m_renderLayer = 0;
+	AlphaMode m_alphaMode = ALPHA_TRANSLUCENT;
+	int m_meshID = -1;
+	glm::vec3 m_scale = glm::vec3(1.0f);
+	GLuint shaderID = 0;
+	GLint m_modelLoc = -1;
+	GLint m_sheetSizeLoc = -1;
+	GLint m_frameIndexLoc = -1;
+	GLint m_scrollOffsetLoc = -1;
+	GLint m_uvRectLoc = -1;
+	GLint m_layerLoc = -1;
+	void setupShaderLocations(const ShaderProgram& shader);
 };
 
@@ -0,0 +1,121 @@
+#include "SpriteBatch.h"
+
+SpriteBatch::SpriteBatch(GLuint shaderID)
+	: m_stream(GL_ARRAY_BUFFER, 256 * 4 * sizeof(Vertex), StreamBuffer::FRAMES_IN_FLIGHT * PASSES_PER_FRAME),
+	m_indexStream(GL_ELEMENT_ARRAY_BUFFER, 256 * 6 * sizeof(GLuint), StreamBuffer::FRAMES_IN_FLIGHT * PASSES_PER_FRAME)
+{
+	glGenVertexArrays(1, &VAO);
+	glBindVertexArray(VAO);
+	for (GLuint location = 0; location <= 6; location++)
+	{
+		glEnableVertexAttribArray(location);
+	}
+	glBindVertexArray(0);
+	this->shaderID = shaderID;
+}
+
+void SpriteBatch::begin()
+{
+	m_sprites.clear();
+	m_runs.clear();
+	m_vertexCount = 0;
+	m_drawCount = 0;
+}
+
+void SpriteBatch::submit(const Sprite& sprite)
+{
+	GLuint textureID = sprite.getTextureID();
+	const Mesh& mesh = MeshRegistry::getMesh(sprite.getMeshID());
+	if (m_runs.empty() || m_runs.back().textureID != textureID)
+	{
+		int firstIndex = m_runs.empty() ? 0 : m_runs.back().firstIndex + m_runs.back().indexCount;
+		m_runs.push_back({ textureID, sprite.getTextureTarget(), firstIndex, 0 });
+	}
+	m_runs.back().indexCount += mesh.indexCount;
+	m_vertexCount += (int)mesh.vertices.size() / 8;
+	m_sprites.push_back(&sprite);
+}
+
+void SpriteBatch::end()
+{
+	if (m_runs.empty())
+	{
+		return;
+	}
+	int indexCount = m_runs.back().firstIndex + m_runs.back().indexCount;
+	glUseProgram(shaderID);
+	glBindVertexArray(VAO);
+
+	//vertices e indices vao direto para o trecho do anel deste passe; os indices
+	//contam a partir do inicio do trecho, para onde os atributos sao apontados
+	Vertex* vertex = (Vertex*)m_stream.map(m_vertexCount * sizeof(Vertex));
+	GLuint* index = (GLuint*)m_indexStream.map(indexCount * sizeof(GLuint));
+	GLuint baseVertex = 0;
+	for (const Sprite* sprite : m_sprites)
+	{
+		const Mesh& mesh = MeshRegistry::getMesh(sprite->getMeshID());
+		glm::vec3 translate = sprite->getTranslate();
+		glm::vec3 scale = sprite->getScale();
+		int meshVertexCount = (int)mesh.vertices.size() / 8;
+		for (int i = 0; i < meshVertexCount; i++, vertex++)
+		{
+			const float* source = &mesh.vertices[i * 8];
+			vertex->position = glm::vec3(source[0], source[1], source[2]) * scale + translate;
+			vertex->textureMapping = glm::vec2(source[6], source[7]);
+			vertex->sheetSize = sprite->getSheetSize();
+			vertex->frameIndex = sprite->getFrameIndex();
+			vertex->scrollOffset = sprite->getScrollOffset();
+			vertex->uvRect = sprite->getUVRect();
+			vertex->layer = sprite->getLayer();
+		}
+		for (GLuint meshIndex : mesh.indices)
+		{
+			*index++ = baseVertex + meshIndex;
+		}
+		baseVertex += meshVertexCount;
+	}
+	m_stream.unmap();
+	m_indexStream.unmap();
+	glBindBuffer(GL_ARRAY_BUFFER, m_stream.getID());
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexStream.getID());
+	setVertexOffset(m_stream.getOffset());
+
+	for (const Run& run : m_runs)
+	{
+		glBindTexture(run.target, run.textureID);
+		glDrawElements(GL_TRIANGLES, run.indexCount, GL_UNSIGNED_INT, (void*)(m_indexStream.getOffset() + run.firstIndex * sizeof(GLuint)));
+		m_drawCount++;
+	}
+	glBindVertexArray(0);
+	m_stream.fence();
+	m_indexStream.fence();
+}
+
+// O trecho do anel muda a cada frame, entao os atributos sao reapontados para ele
+void SpriteBatch::setVertexOffset(size_t offset)
+{
+	//atributo de posicao (ja transformada pelo model do sprite)
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, position)));
+	//atributo de coordenada de textura
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, textureMapping)));
+	//atributos da spritesheet, que antes eram uniforms
+	glVertexAttribIPointer(2, 2, GL_INT, sizeof(Vertex), (void*)(offset + offsetof(Vertex, sheetSize)));
+	glVertexAttribIPointer(3, 1, GL_INT, sizeof(Vertex), (void*)(offset + offsetof(Vertex, frameIndex)));
+	glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, scrollOffset)));
+	//sub-retangulo do atlas
+	glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(offset + offsetof(Vertex, uvRect)));
+	//camada da GL_TEXTURE_2D_ARRAY
+	glVertexAttribIPointer(6, 1, GL_INT, sizeof(Vertex), (void*)(offset + offsetof(Vertex, layer)));
+}
+
+void SpriteBatch::deleteBuffers()
+{
+	glDeleteVertexArrays(1, &VAO);
+	m_stream.deleteBuffer();
+	m_indexStream.deleteBuffer();
+}
+
+int SpriteBatch::getDrawCount() const
+{
+	return m_drawCount;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include <cstddef>
+#include "Sprite.h"
+#include "StreamBuffer.h"
+
+// Junta os sprites de um frame em um unico buffer de vertices e faz uma
+// chamada de desenho para cada sequencia de sprites com a mesma textura.
+// Cada sprite entra com a sua malha do MeshRegistry (o quad ou o poligono recortado
+// pelo alfa). Vertices e indices sao escritos direto nos StreamBuffers mapeados,
+// sem copia intermediaria.
+class SpriteBatch
+{
+public:
+	SpriteBatch(GLuint shaderID);
+	void begin();
+	void submit(const Sprite& sprite);
+	void end();
+	void deleteBuffers();
+	int getDrawCount() const;
+private:
+	struct Vertex
+	{
+		glm::vec3 position;
+		glm::vec2 textureMapping;
+		glm::ivec2 sheetSize;
+		int frameIndex;
+		glm::vec2 scrollOffset;
+		glm::vec4 uvRect;
+		int layer;
+	};
+	struct Run
+	{
+		GLuint textureID;
+		GLenum target;
+		int firstIndex;
+		int indexCount;
+	};
+	// end() roda uma vez no passe opaco e outra no translucido
+	static const int PASSES_PER_FRAME = 2;
+	void setVertexOffset(size_t offset);
+	std::vector<const Sprite*> m_sprites;
+	std::vector<Run> m_runs;
+	int m_vertexCount = 0;
+	int m_drawCount = 0;
+	GLuint VAO;
+	StreamBuffer m_stream;
+	StreamBuffer m_indexStream;
+	GLuint shaderID;
+};
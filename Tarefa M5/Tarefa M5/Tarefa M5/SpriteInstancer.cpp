@@ -0,0 +1,153 @@
+#include "SpriteInstancer.h"
+
+SpriteInstancer::SpriteInstancer(GLuint shaderID)
+	: m_stream(GL_ARRAY_BUFFER, 256 * sizeof(Instance), StreamBuffer::FRAMES_IN_FLIGHT * PASSES_PER_FRAME)
+{
+	//Reaproveita os buffers das malhas do MeshRegistry, so o VAO e proprio
+	m_meshID = MeshRegistry::acquire(MeshRegistry::UNIT_QUAD);
+	glGenVertexArrays(1, &VAO);
+	glBindVertexArray(VAO);
+	bindMesh(MeshRegistry::getMesh(m_meshID));
+	//atributos de posicao e de coordenada de textura (mesma location do shader do Sprite)
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(2);
+
+	//atributos por instancia (apontados para o StreamBuffer a cada frame)
+	for (GLuint location = 3; location <= 9; location++)
+	{
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+	glBindVertexArray(0);
+	this->shaderID = shaderID;
+}
+
+void SpriteInstancer::begin(bool keepOrder)
+{
+	//mantem os vetores alocados entre frames, so zera o tamanho
+	for (int i = 0; i < m_groupCount; i++)
+	{
+		m_groups[i].sprites.clear();
+	}
+	m_groupByKey.clear();
+	m_groupCount = 0;
+	m_drawCount = 0;
+	m_keepOrder = keepOrder;
+}
+
+void SpriteInstancer::submit(const Sprite& sprite)
+{
+	GLuint textureID = sprite.getTextureID();
+	uint64_t key = (uint64_t)textureID << 32 | (uint32_t)sprite.getMeshID();
+	int group;
+	if (m_keepOrder)
+	{
+		//so continua o ultimo grupo; outro par abre um grupo novo mesmo que ja tenha aparecido
+		const Group* last = m_groupCount > 0 ? &m_groups[m_groupCount - 1] : nullptr;
+		group = last && last->textureID == textureID && last->meshID == sprite.getMeshID() ? m_groupCount - 1 : -1;
+	}
+	else
+	{
+		auto found = m_groupByKey.find(key);
+		group = found == m_groupByKey.end() ? -1 : found->second;
+	}
+	if (group < 0)
+	{
+		group = m_groupCount++;
+		if (group == (int)m_groups.size())
+		{
+			m_groups.push_back(Group());
+		}
+		m_groups[group].textureID = textureID;
+		m_groups[group].target = sprite.getTextureTarget();
+		m_groups[group].meshID = sprite.getMeshID();
+		if (!m_keepOrder)
+		{
+			m_groupByKey[key] = group;
+		}
+	}
+
+	m_groups[group].sprites.push_back(&sprite);
+}
+
+void SpriteInstancer::end()
+{
+	if (m_groupCount == 0)
+	{
+		return;
+	}
+	//os grupos sao escritos em sequencia no trecho do anel deste passe;
+	//cada grupo aponta os atributos para o seu pedaco
+	size_t instanceCount = 0;
+	for (int i = 0; i < m_groupCount; i++)
+	{
+		instanceCount += m_groups[i].sprites.size();
+	}
+	Instance* instance = (Instance*)m_stream.map(instanceCount * sizeof(Instance));
+	for (int i = 0; i < m_groupCount; i++)
+	{
+		for (const Sprite* sprite : m_groups[i].sprites)
+		{
+			instance->translate = sprite->getTranslate();
+			instance->scale = sprite->getScale();
+			instance->sheetSize = sprite->getSheetSize();
+			instance->frameIndex = sprite->getFrameIndex();
+			instance->scrollOffset = sprite->getScrollOffset();
+			instance->uvRect = sprite->getUVRect();
+			instance->layer = sprite->getLayer();
+			instance++;
+		}
+	}
+	m_stream.unmap();
+	glUseProgram(shaderID);
+	glBindVertexArray(VAO);
+	size_t firstInstance = 0;
+	for (int i = 0; i < m_groupCount; i++)
+	{
+		GLsizei count = (GLsizei)m_groups[i].sprites.size();
+		const Mesh& mesh = MeshRegistry::getMesh(m_groups[i].meshID);
+		bindMesh(mesh);
+		glBindBuffer(GL_ARRAY_BUFFER, m_stream.getID());
+		setInstanceOffset(m_stream.getOffset() + firstInstance * sizeof(Instance));
+		glBindTexture(m_groups[i].target, m_groups[i].textureID);
+		glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, 0, count);
+		firstInstance += count;
+		m_drawCount++;
+	}
+	glBindVertexArray(0);
+	m_stream.fence();
+}
+
+// O loader da glad so tem ate a OpenGL 3.3 (sem baseInstance), entao cada grupo
+// reaponta os atributos por instancia para o inicio do seu trecho no buffer
+void SpriteInstancer::setInstanceOffset(size_t offset)
+{
+	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, translate)));
+	glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, scale)));
+	glVertexAttribIPointer(5, 2, GL_INT, sizeof(Instance), (void*)(offset + offsetof(Instance, sheetSize)));
+	glVertexAttribIPointer(6, 1, GL_INT, sizeof(Instance), (void*)(offset + offsetof(Instance, frameIndex)));
+	glVertexAttribPointer(7, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, scrollOffset)));
+	glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(offset + offsetof(Instance, uvRect)));
+	glVertexAttribIPointer(9, 1, GL_INT, sizeof(Instance), (void*)(offset + offsetof(Instance, layer)));
+}
+
+// Aponta posicao e coordenada de textura para os buffers da malha do grupo
+void SpriteInstancer::bindMesh(const Mesh& mesh)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+}
+
+void SpriteInstancer::deleteBuffers()
+{
+	glDeleteVertexArrays(1, &VAO);
+	m_stream.deleteBuffer();
+	MeshRegistry::release(m_meshID);
+}
+
+int SpriteInstancer::getDrawCount() const
+{
+	return m_drawCount;
+}
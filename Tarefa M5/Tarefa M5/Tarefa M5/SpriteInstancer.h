@@ -0,0 +1,58 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "Sprite.h"
+#include "StreamBuffer.h"
+
+// Desenha os sprites com instancing: translate, scale e os dados da spritesheet
+// vao num buffer por instancia e cada par textura/malha vira um unico
+// glDrawElementsInstanced. Os grupos sao desenhados na ordem em que o par
+// apareceu pela primeira vez no frame. Com keepOrder (passe translucido) so
+// sprites seguidos com o mesmo par entram no mesmo grupo, como as sequencias do
+// SpriteBatch, para nao quebrar a ordem de tras para frente.
+// As instancias sao escritas direto no StreamBuffer mapeado.
+class SpriteInstancer
+{
+public:
+	SpriteInstancer(GLuint shaderID);
+	void begin(bool keepOrder = false);
+	void submit(const Sprite& sprite);
+	void end();
+	void deleteBuffers();
+	int getDrawCount() const;
+private:
+	struct Instance
+	{
+		glm::vec3 translate;
+		glm::vec3 scale;
+		glm::ivec2 sheetSize;
+		int frameIndex;
+		glm::vec2 scrollOffset;
+		glm::vec4 uvRect;
+		int layer;
+	};
+	struct Group
+	{
+		GLuint textureID;
+		GLenum target;
+		int meshID;
+		std::vector<const Sprite*> sprites;
+	};
+	// end() roda uma vez no passe opaco e outra no translucido
+	static const int PASSES_PER_FRAME = 2;
+	void setInstanceOffset(size_t offset);
+	void bindMesh(const Mesh& mesh);
+	std::vector<Group> m_groups;
+	std::unordered_map<uint64_t, int> m_groupByKey;
+	int m_groupCount = 0;
+	bool m_keepOrder = false;
+	int m_drawCount = 0;
+	int m_meshID;
+	GLuint VAO;
+	StreamBuffer m_stream;
+	GLuint shaderID;
+};
@@ -0,0 +1,90 @@
+#include "SpriteState.h"
+
+// Posicionar direto (sem update) no interpola a partir da posio antiga
+void SpriteState::setTranslate(glm::vec3 translate)
+{
+	m_translate = translate;
+	m_previousTranslate = translate;
+}
+
+void SpriteState::setSpriteSheet(int cols, int rows)
+{
+	m_sheetCols = cols;
+	m_sheetRows = rows;
+}
+
+void SpriteState::update(float deltaTime)
+{
+	
+}
+
+void SpriteState::setVelocity(const glm::vec3& velocity)
+{
+	m_velocity = velocity;
+}
+
+glm::vec3 SpriteState::getVelocity() const
+{
+	return m_velocity;
+}
+
+glm::vec3 SpriteState::getTranslate() const
+{
+	return m_translate;
+}
+
+// Guarda a posio antes de um passo da simulao, para o desenho interpolar
+void SpriteState::savePreviousTranslate()
+{
+	m_previousTranslate = m_translate;
+}
+
+// Posio entre o passo anterior (alpha 0) e o atual (alpha 1)
+glm::vec3 SpriteState::getInterpolatedTranslate(float alpha) const
+{
+	return glm::mix(m_previousTranslate, m_translate, alpha);
+}
+
+int SpriteState::getFrameIndex() const
+{
+	return m_frameIndex;
+}
+
+glm::ivec2 SpriteState::getSheetSize() const
+{
+	return glm::ivec2(m_sheetCols, m_sheetRows);
+}
+
+bool SpriteState::updateAnimationFromVelocity()
+{
+	if (glm::length(m_velocity) < 0.01f) 
+	{
+		m_frameIndex = 24;
+		return true;
+	}
+
+	if (m_velocity.x > 0)
+	{
+		m_animationRow = 1; // direita
+		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
+		return false;
+	}
+	else if (m_velocity.x < 0)
+	{
+		m_animationRow = 2; // esquerda
+		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
+		return false;
+	}
+	else if(m_velocity.y > 0)
+	{
+		m_animationRow = 0; // cima
+		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
+		return false;
+	}
+	else if (m_velocity.y < 0)
+	{
+		m_animationRow = 3; // baixo
+		m_frameIndex = (int)(m_animationRow * m_sheetCols + (m_frameIndex % m_sheetCols)); // Atualiza o frameIndex baseado na linha da animao
+		return false;
+	}
+}
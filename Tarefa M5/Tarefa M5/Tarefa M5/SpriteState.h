@@ -0,0 +1,33 @@
+#pragma once
+#include "dependencies/glm/glm.hpp"
+
+// Estado de simulacao de um sprite: posicao, velocidade e animacao da spritesheet,
+// sem nada de OpenGL. O Sprite acrescenta textura, malha e shader; os
+// microbenchmarks de CPU usam so esta parte
+class SpriteState
+{
+public:
+	virtual ~SpriteState() {}
+	void setTranslate(glm::vec3 translate);
+	void setSpriteSheet(int cols, int rows);
+	virtual void update(float deltaTime);
+	void setVelocity(const glm::vec3& velocity);
+	glm::vec3 getVelocity() const;
+	glm::vec3 getTranslate() const;
+	void savePreviousTranslate();
+	glm::vec3 getInterpolatedTranslate(float alpha) const;
+	int getFrameIndex() const;
+	glm::ivec2 getSheetSize() const;
+protected:
+	glm::vec3 m_translate = glm::vec3(0.0f);
+	glm::vec3 m_previousTranslate = glm::vec3(0.0f);
+	int m_sheetCols = 1;
+	int m_sheetRows = 1;
+	int m_frameIndex = 0;
+	int m_animationRow = 0;
+	int m_currentFrame = 0;
+	float m_animTimer = 0.0f;
+	float m_frameDuration = 0.1f;
+	glm::vec3 m_velocity = glm::vec3(0.0f);
+	bool updateAnimationFromVelocity();
+};
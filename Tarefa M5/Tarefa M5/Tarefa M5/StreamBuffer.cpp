@@ -0,0 +1,156 @@
+#include "StreamBuffer.h"
+#include "dependencies/glfw/include/GLFW/glfw3.h"
+#include <cstring>
+
+// O loader da glad so carrega ate a OpenGL 3.3, entao o glBufferStorage vem direto da GLFW
+static PFNGLBUFFERSTORAGEPROC loadBufferStorage()
+{
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	bool supported = major > 4 || (major == 4 && minor >= 4);
+	GLint extensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+	for (GLint i = 0; i < extensionCount && !supported; i++)
+	{
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		supported = std::strcmp(extension, "GL_ARB_buffer_storage") == 0;
+	}
+	if (!supported)
+	{
+		return nullptr;
+	}
+	PFNGLBUFFERSTORAGEPROC bufferStorage = (PFNGLBUFFERSTORAGEPROC)glfwGetProcAddress("glBufferStorage");
+	if (!bufferStorage)
+	{
+		bufferStorage = (PFNGLBUFFERSTORAGEPROC)glfwGetProcAddress("glBufferStorageARB");
+	}
+	return bufferStorage;
+}
+
+StreamBuffer::StreamBuffer(GLenum target, GLsizeiptr sectionSize, int sectionCount)
+{
+	m_target = target;
+	m_sectionCount = sectionCount;
+	m_fences.assign(sectionCount, (GLsync)0);
+	allocate(sectionSize);
+}
+
+// Devolve onde escrever os dados deste frame. Se nao couber no trecho, o anel e
+// recriado com trechos maiores (depois de esperar a GPU liberar todos eles).
+void* StreamBuffer::map(GLsizeiptr size)
+{
+	if (size > m_sectionSize)
+	{
+		for (int i = 0; i < m_sectionCount; i++)
+		{
+			waitSection(i);
+		}
+		deleteBuffer();
+		GLsizeiptr sectionSize = m_sectionSize * 2;
+		while (sectionSize < size)
+		{
+			sectionSize *= 2;
+		}
+		allocate(sectionSize);
+	}
+	waitSection(m_section);
+	if (m_persistent)
+	{
+		return m_persistentPointer + getOffset();
+	}
+	glBindBuffer(m_target, m_bufferID);
+	return glMapBufferRange(m_target, getOffset(), size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void StreamBuffer::unmap()
+{
+	if (!m_persistent)
+	{
+		glBindBuffer(m_target, m_bufferID);
+		glUnmapBuffer(m_target);
+	}
+}
+
+// Chamado depois dos desenhos que leem o trecho atual; passa para o proximo trecho
+void StreamBuffer::fence()
+{
+	m_fences[m_section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_section = (m_section + 1) % m_sectionCount;
+}
+
+GLuint StreamBuffer::getID() const
+{
+	return m_bufferID;
+}
+
+GLintptr StreamBuffer::getOffset() const
+{
+	return m_section * m_sectionSize;
+}
+
+bool StreamBuffer::isPersistent() const
+{
+	return m_persistent;
+}
+
+void StreamBuffer::deleteBuffer()
+{
+	for (GLsync& sync : m_fences)
+	{
+		if (sync)
+		{
+			glDeleteSync(sync);
+			sync = 0;
+		}
+	}
+	if (m_persistent)
+	{
+		glBindBuffer(m_target, m_bufferID);
+		glUnmapBuffer(m_target);
+		m_persistentPointer = nullptr;
+	}
+	glDeleteBuffers(1, &m_bufferID);
+	m_bufferID = 0;
+}
+
+void StreamBuffer::allocate(GLsizeiptr sectionSize)
+{
+	//trechos alinhados em 256 bytes, o que serve para vertices e para uniform buffers
+	m_sectionSize = (sectionSize + 255) / 256 * 256;
+	m_section = 0;
+	GLsizeiptr totalSize = m_sectionSize * m_sectionCount;
+	static PFNGLBUFFERSTORAGEPROC bufferStorage = loadBufferStorage();
+
+	glGenBuffers(1, &m_bufferID);
+	glBindBuffer(m_target, m_bufferID);
+	m_persistent = bufferStorage != nullptr;
+	if (m_persistent)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		bufferStorage(m_target, totalSize, NULL, flags);
+		m_persistentPointer = (unsigned char*)glMapBufferRange(m_target, 0, totalSize, flags);
+	}
+	else
+	{
+		glBufferData(m_target, totalSize, NULL, GL_STREAM_DRAW);
+	}
+	glBindBuffer(m_target, 0);
+}
+
+void StreamBuffer::waitSection(int section)
+{
+	GLsync& sync = m_fences[section];
+	if (!sync)
+	{
+		return;
+	}
+	//normalmente a fence ja passou; so espera se a CPU estiver o anel inteiro a frente da GPU
+	GLenum result = glClientWaitSync(sync, 0, 0);
+	while (result == GL_TIMEOUT_EXPIRED)
+	{
+		result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	}
+	glDeleteSync(sync);
+	sync = 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+
+// Buffer em anel para dados que mudam todo frame. O buffer e dividido em trechos
+// (um por frame em voo, por padrao) e fica mapeado o tempo todo com glBufferStorage +
+// GL_MAP_PERSISTENT_BIT, entao a CPU escreve direto na memoria que a GPU le. Uma fence
+// por trecho garante que a CPU so sobrescreve um trecho depois que a GPU terminou de
+// usa-lo, sem a sincronizacao implicita do glBufferData/glBufferSubData.
+// Sem glBufferStorage (OpenGL < 4.4 e sem ARB_buffer_storage) cada frame mapeia o
+// seu trecho com GL_MAP_UNSYNCHRONIZED_BIT, protegido pelas mesmas fences.
+// Cada map/fence consome um trecho, entao quem usa o buffer mais de uma vez por
+// frame precisa de FRAMES_IN_FLIGHT trechos para cada uso.
+class StreamBuffer
+{
+public:
+	static const int FRAMES_IN_FLIGHT = 3;
+	StreamBuffer(GLenum target, GLsizeiptr sectionSize, int sectionCount = FRAMES_IN_FLIGHT);
+	void* map(GLsizeiptr size);
+	void unmap();
+	void fence();
+	GLuint getID() const;
+	GLintptr getOffset() const;
+	bool isPersistent() const;
+	void deleteBuffer();
+private:
+	void allocate(GLsizeiptr sectionSize);
+	void waitSection(int section);
+	GLenum m_target;
+	GLsizeiptr m_sectionSize = 0;
+	int m_sectionCount;
+	int m_section = 0;
+	std::vector<GLsync> m_fences;
+	bool m_persistent = false;
+	unsigned char* m_persistentPointer = nullptr;
+	GLuint m_bufferID = 0;
+};
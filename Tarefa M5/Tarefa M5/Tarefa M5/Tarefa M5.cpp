@@ -8,9 +8,32 @@
 #include "dependencies/glm/gtc/matrix_transform.hpp"
 #include "dependencies/glm/gtc/type_ptr.hpp"
 #include <vector>
-#include <random>
 #include <cmath>
+#include <cstdlib>
 #include "ControllableCharacter.h"
+#include "SpriteBatch.h"
+#include "SpriteInstancer.h"
+#include "ShaderProgram.h"
+#include "FrameUniforms.h"
+#include "TextureArray.h"
+#include "RenderQueue.h"
+#include "Camera2D.h"
+#include "SpatialHash.h"
+#include "ParallaxBackground.h"
+#include "OffscreenTarget.h"
+#include "ImageFile.h"
+#include "SoftwareRenderer.h"
+#include "FrameExchange.h"
+#include "GpuProfiler.h"
+#include "ProfilerOverlay.h"
+#include "FrameStats.h"
+#include "../../../Common/FramePacer.h"
+#include "GLInstrumentation.h"
+#include "Shaders.h"
+#include "Scene.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 // Prottipo da funo de callback de teclado
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);
@@ -18,63 +41,118 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 
 // Prottipos das funes
-int setupShader();
+int renderSoftware(const std::vector<SceneSprite>& scene, bool followPlayer, int threadCount, const char* dumpPath, const char* goldenPath, int tolerance);
 
-// Dimenses da janela (pode ser alterado em tempo de execuo)
-const GLuint WIDTH = 800, HEIGHT = 600;
+// Estratgias de desenho dos sprites (trocadas pelas teclas 1, 2 e 3)
+enum DrawMode { DRAW_PER_SPRITE, DRAW_BATCHED, DRAW_INSTANCED };
+DrawMode drawMode = DRAW_BATCHED;
 
-// Cdigo fonte do Vertex Shader (em GLSL): ainda hardcoded
-const GLchar* vertexShaderSource = R"(#version 400
-layout (location = 0) in vec3 position;
-layout (location = 1) in vec3 colors;
-layout (location = 2) in vec2 texture_mapping;
-
-out vec2 texture_coordinates;
-out vec3 color_values;
-
-uniform mat4 projection;
-uniform mat4 model;
-uniform vec2 scrollOffset;
-
-uniform ivec2 sheetSize;   
-uniform int frameIndex;
+std::vector<Sprite*> sprites;
 
-void main()
-{
-    int column = frameIndex % sheetSize.x;
-    int row    = frameIndex / sheetSize.x;
-    vec2 cellSize = vec2(1.0) / vec2(sheetSize);
-    vec2 frameOffset = vec2(column, row) * cellSize;
-    texture_coordinates = texture_mapping * cellSize + frameOffset + scrollOffset;
-    color_values = colors;
-    gl_Position = projection * model * vec4(position, 1.0);
-})";
-
-//Cdigo fonte do Fragment Shader (em GLSL): ainda hardcoded
-const GLchar* fragmentShaderSource = R"(#version 400
-in vec2 texture_coordinates;
-in vec3 color_values;
-out vec4 color;
-
-uniform sampler2D spriteTexture;
-
-void main()
-{
-    vec4 texColor = texture(spriteTexture, texture_coordinates);
-    color = texColor;
-}
-)";
+// Tempos entre os swaps; a tecla F imprime os percentis at agora
+FrameStats frameStats;
 
-std::vector<Sprite*> sprites;
+// A simulao anda em passos fixos de 1/120 s, independente do FPS; o desenho
+// interpola as posies entre os dois ltimos passos. Um frame mais longo que
+// MAX_FRAME_TIME (janela arrastada, breakpoint) s conta at esse limite
+const double SIMULATION_STEP = 1.0 / 120.0;
+const double MAX_FRAME_TIME = 0.25;
 
 // Funo MAIN
-int main()
+int main(int argc, char** argv)
 {
-	// Inicializao da GLFW
+	// Com --texture-array as imagens viram camadas de uma GL_TEXTURE_2D_ARRAY em vez de um atlas
+	bool useTextureArray = false;
+	// Com --world-sprites N, N inimigos so espalhados por um mundo maior que a janela
+	// e a cmera segue o personagem
+	int worldSprites = 0;
+	// Com --headless no h janela visvel: o contexto  surfaceless (EGL, ou OSMesa com
+	// --osmesa) e o desenho vai para um framebuffer prprio. --frames N encerra depois de
+	// N frames, --dump salva o ltimo frame em PPM e --golden compara o ltimo frame com
+	// uma imagem de referncia (o programa retorna 1 se houver diferena)
+	bool headless = false;
+	bool useOSMesa = false;
+	int frameLimit = 0;
+	// Com --bench-seconds N a cena roda por N segundos de relgio e o relatrio dos tempos
+	// de frame sai tambm numa linha JSON
+	double benchSeconds = 0.0;
+	const char* dumpPath = nullptr;
+	const char* goldenPath = nullptr;
+	int tolerance = 2;
+	// Com --software a cena  desenhada uma vez pelo SoftwareRenderer, sem OpenGL nem
+	// janela (--threads N escolhe quantas threads; o padro  uma por ncleo)
+	bool software = false;
+	int threadCount = 0;
+	// Com --single-thread a simulao e o desenho voltam a rodar em sequncia na mesma thread
+	bool singleThread = false;
+	// Com --profile os passes so medidos na GPU e o painel aparece por cima da cena
+	bool profile = false;
+	// Com --gl-stats as chamadas OpenGL so contadas (uma linha por segundo) e as
+	// mensagens de GL_KHR_debug do driver vo para o log
+	bool glStats = false;
+	// --fps N limita a taxa de frames (0 = sem limite) e --vsync off|on|adaptive escolhe
+	// o vsync; o padro  adaptativo, ou desligado no modo headless
+	double targetFps = 0.0;
+	const char* vsyncMode = nullptr;
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--texture-array")
+			useTextureArray = true;
+		if (std::string(argv[i]) == "--world-sprites" && i + 1 < argc)
+			worldSprites = std::atoi(argv[++i]);
+		if (std::string(argv[i]) == "--headless")
+			headless = true;
+		if (std::string(argv[i]) == "--osmesa")
+			useOSMesa = true;
+		if (std::string(argv[i]) == "--frames" && i + 1 < argc)
+			frameLimit = std::atoi(argv[++i]);
+		if (std::string(argv[i]) == "--bench-seconds" && i + 1 < argc)
+			benchSeconds = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--dump" && i + 1 < argc)
+			dumpPath = argv[++i];
+		if (std::string(argv[i]) == "--golden" && i + 1 < argc)
+			goldenPath = argv[++i];
+		if (std::string(argv[i]) == "--tolerance" && i + 1 < argc)
+			tolerance = std::atoi(argv[++i]);
+		if (std::string(argv[i]) == "--software")
+			software = true;
+		if (std::string(argv[i]) == "--threads" && i + 1 < argc)
+			threadCount = std::atoi(argv[++i]);
+		if (std::string(argv[i]) == "--single-thread")
+			singleThread = true;
+		if (std::string(argv[i]) == "--profile")
+			profile = true;
+		if (std::string(argv[i]) == "--gl-stats")
+			glStats = true;
+		if (std::string(argv[i]) == "--fps" && i + 1 < argc)
+			targetFps = std::atof(argv[++i]);
+		if (std::string(argv[i]) == "--vsync" && i + 1 < argc)
+			vsyncMode = argv[++i];
+	}
+	std::vector<SceneSprite> scene = buildScene(worldSprites);
+	if (software)
+		return renderSoftware(scene, worldSprites > 0, threadCount, dumpPath, goldenPath, tolerance);
+
+	// Inicializao da GLFW (sem display, a plataforma nula dispensa o sistema de janelas)
+	if (headless)
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
 	glfwInit();
 
 	// Criao da janela GLFW
+	if (headless)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API, useOSMesa ? GLFW_OSMESA_CONTEXT_API : GLFW_EGL_CONTEXT_API);
+	}
+	if (glStats)
+		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
 	GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Ola Triangulo! -- Lucas Kappes", nullptr, nullptr);
+	if (!window)
+	{
+		std::cerr << "Erro ao criar a janela" << std::endl;
+		glfwTerminate();
+		return -1;
+	}
 	glfwMakeContextCurrent(window);
 
 	// Fazendo o registro da funo de callback para a janela GLFW
@@ -86,6 +164,11 @@ int main()
 	{
 		std::cout << "Failed to initialize GLAD" << std::endl;
 	}
+	if (glStats)
+	{
+		installGLCallCounters();
+		enableGLDebugOutput();
+	}
 
 	// Obtendo as informaes de verso
 	const GLubyte* renderer = glGetString(GL_RENDERER);
@@ -98,82 +181,367 @@ int main()
 	glfwGetFramebufferSize(window, &width, &height);
 	glViewport(0, 0, width, height);
 
+	// Ritmo dos frames: espera o FPS alvo, vsync e medida do jitter entre apresentaes
+	FramePacer framePacer(window, targetFps, vsyncMode ? FramePacer::parseVsyncMode(vsyncMode) : headless ? FramePacer::VSYNC_OFF : FramePacer::VSYNC_ADAPTIVE);
+
+	// No modo headless tudo  desenhado no framebuffer offscreen
+	OffscreenTarget* offscreen = nullptr;
+	if (headless)
+	{
+		offscreen = new OffscreenTarget(width, height);
+		offscreen->bind();
+	}
 
 	// Compilando e buildando o programa de shader
-	GLuint shaderID = setupShader();
+	const GLchar* spriteFragmentShaderSource = useTextureArray ? arrayFragmentShaderSource : fragmentShaderSource;
+	ShaderProgram shader(setupShader(vertexShaderSource, spriteFragmentShaderSource));
+	ShaderProgram batchShader(setupShader(batchVertexShaderSource, spriteFragmentShaderSource));
+	ShaderProgram instancedShader(setupShader(instancedVertexShaderSource, spriteFragmentShaderSource));
+	ShaderProgram parallaxShader(setupShader(parallaxVertexShaderSource, parallaxFragmentShaderSource));
+	ShaderProgram overlayShader(setupShader(overlayVertexShaderSource, overlayFragmentShaderSource));
+	GLuint shaderID = shader.getID();
 
 	glUseProgram(shaderID);
 
-	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDepthFunc(GL_LEQUAL);
 
 	// Enviando a cor desejada (vec4) para o fragment shader
 	// Utilizamos a variveis do tipo uniform em GLSL para armazenar esse tipo de info
 	// que no est nos buffers
 	GLint colorLoc = glGetUniformLocation(shaderID, "inputColor");
 
-	//Matriz de projeo paralela ortogrfica
-	glm::mat4 projection = glm::ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);
-	glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, value_ptr(projection));
+	// A cmera gera a matriz de projeo paralela ortogrfica a cada frame
+	Camera2D camera(WIDTH, HEIGHT);
+
+	// Projeo e tempo vo num uniform buffer compartilhado pelos trs shaders
+	FrameUniforms frameUniforms;
+	frameUniforms.attach(shader);
+	frameUniforms.attach(batchShader);
+	frameUniforms.attach(instancedShader);
+
+	// Limite de alfa dos trs programas de sprite: 0.5 no passe opaco (recorte) e 0 no translcido
+	const ShaderProgram* spritePrograms[] = { &shader, &batchShader, &instancedShader };
+	auto setAlphaCutoff = [&spritePrograms](float cutoff) {
+		for (const ShaderProgram* program : spritePrograms)
+		{
+			glUseProgram(program->getID());
+			glUniform1f(program->getUniformLocation("alphaCutoff"), cutoff);
+		}
+	};
 
-	sprites.push_back(new Sprite("assets/orig.png", shaderID));
-	sprites[0]->setScale(glm::vec3(800, 600, 0));
-	sprites[0]->setTranslate(glm::vec3(400, 300, 0));
+	SpriteBatch spriteBatch(batchShader.getID());
+	SpriteInstancer spriteInstancer(instancedShader.getID());
+	RenderQueue renderQueue;
 
-	sprites.push_back(new Sprite("assets/samurai.png", shaderID));
-	sprites[1]->setScale(glm::vec3(100, 100, 0));
-	sprites[1]->setTranslate(glm::vec3(100, 100, 0));
+	TextureAtlas atlas;
+	TextureArray textureArray;
+	std::vector<AtlasRegion> regions;
+	for (int i = 0; i < IMAGE_COUNT; i++)
+	{
+		const SpriteImage& image = images[i];
+		if (useTextureArray)
+			textureArray.addImage(image.path, image.columns, image.rows);
+		else
+			atlas.addImage(image.path, image.columns, image.rows);
+	}
+	if (useTextureArray)
+		textureArray.build();
+	else
+		atlas.build();
+	for (int i = 0; i < IMAGE_COUNT; i++)
+	{
+		regions.push_back(useTextureArray ? textureArray.getRegion(i) : atlas.getRegion(i));
+	}
 
-	sprites.push_back(new Sprite("assets/hood_archer.png", shaderID));
-	sprites[2]->setScale(glm::vec3(100, 100, 0));
-	sprites[2]->setTranslate(glm::vec3(300, 100, 0));
+	// O cenrio  a primeira camada do fundo, repetida a cada 800x600 do mundo
+	ParallaxBackground background(parallaxShader);
+	background.addLayer("assets/orig.png", 1.0f, glm::vec2(WIDTH, HEIGHT));
 
-	sprites.push_back(new Sprite("assets/monster0.png", shaderID));
-	sprites[3]->setScale(glm::vec3(150, 150, 0));
-	sprites[3]->setTranslate(glm::vec3(200, 400, 0));
+	for (size_t i = 0; i < scene.size(); i++)
+	{
+		const SceneSprite& item = scene[i];
+		Sprite* sprite = i == PLAYER ? new ControllableCharacter(regions[item.image], shader) : new Sprite(regions[item.image], shader);
+		sprite->setScale(item.scale);
+		sprite->setTranslate(item.translate);
+		sprite->setSpriteSheet(images[item.image].columns, images[item.image].rows);
+		sprite->setRenderLayer(item.renderLayer);
+		sprites.push_back(sprite);
+	}
+	if (worldSprites > 0)
+		camera.setWorldBounds(glm::vec4(0.0f, 0.0f, WORLD_SIZE));
 
-	sprites.push_back(new Sprite("assets/monster1.png", shaderID));
-	sprites[4]->setScale(glm::vec3(180, 180, 0));
-	sprites[4]->setTranslate(glm::vec3(600, 300, 0));
+	// Cada sprite ganha um z prprio que reproduz a ordem de pintura (camada e depois
+	// ordem de criao), para o teste de profundidade resolver a sobreposio no passe opaco
+	for (size_t i = 0; i < sprites.size(); i++)
+	{
+		glm::vec3 translate = sprites[i]->getTranslate();
+		translate.z = sprites[i]->getRenderLayer() * 0.1f + (float)i / sprites.size() * 0.09f;
+		sprites[i]->setTranslate(translate);
+	}
 
-	sprites.push_back(new Sprite("assets/monster2.png", shaderID));
-	sprites[5]->setScale(glm::vec3(200, 200, 0));
-	sprites[5]->setTranslate(glm::vec3(600, 100, 0));
+	// S os sprites que tocam a vista da cmera so enviados para desenho
+	SpatialHash spatialHash;
+	for (Sprite* sprite : sprites)
+		spatialHash.insert(sprite);
+	std::vector<Sprite*> visibleSprites;
 
-	sprites.push_back(new ControllableCharacter("assets/Sword_Run_full.png", shaderID));
-	sprites[6]->setScale(glm::vec3(100, 100, 0));
-	sprites[6]->setTranslate(glm::vec3(400, 400, 0));
-	sprites[6]->setSpriteSheet(8, 4); 
-	sprites[6]->setVelocity(glm::vec3(0, 0, 0));
+	// Os resultados da GPU chegam alguns frames depois; o painel mostra o ltimo lido
+	GpuProfiler* profiler = nullptr;
+	ProfilerOverlay* overlay = nullptr;
+	if (profile)
+	{
+		profiler = new GpuProfiler();
+		overlay = new ProfilerOverlay(overlayShader);
+	}
+	auto beginScope = [&profiler](const char* name) {
+		if (profiler)
+			profiler->beginScope(name);
+	};
+	auto endScope = [&profiler](int drawCount) {
+		if (profiler)
+			profiler->endScope(drawCount);
+	};
+
+	// Desenha um snapshot; roda na thread que tem o contexto OpenGL
+	auto renderFrame = [&](FrameSnapshot& frame) {
+		if (profiler)
+		{
+			if (profiler->beginFrame())
+				overlay->update(profiler->getResults());
+			profiler->addCpuScope("SIMULACAO", frame.simulationMs);
+		}
+		beginScope("LIMPAR");
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		endScope(0);
+		frameUniforms.update(frame.camera.getProjection(), frame.time);
+
+		// Os sprites vo para a fila e so desenhados na ordem das chaves, no na de criao
+		renderQueue.clear();
+		for (Sprite& sprite : frame.sprites) {
+			renderQueue.push(&sprite);
+		}
+		renderQueue.sort();
+		const std::vector<DrawCommand>& commands = renderQueue.getCommands();
+		int firstTranslucent = renderQueue.getFirstTranslucent();
+
+		// Desenha os comandos [first, last) com a estratgia escolhida e retorna as draw calls
+		auto drawCommands = [&](int first, int last) {
+			if (frame.drawMode == DRAW_PER_SPRITE)
+			{
+				glUseProgram(shaderID);
+				for (int i = first; i < last; i++) {
+					commands[i].sprite->Draw();
+				}
+				return last - first;
+			}
+			else if (frame.drawMode == DRAW_BATCHED)
+			{
+				spriteBatch.begin();
+				for (int i = first; i < last; i++) {
+					spriteBatch.submit(*commands[i].sprite);
+				}
+				spriteBatch.end();
+				return spriteBatch.getDrawCount();
+			}
+			else
+			{
+				spriteInstancer.begin(first >= firstTranslucent);
+				for (int i = first; i < last; i++) {
+					spriteInstancer.submit(*commands[i].sprite);
+				}
+				spriteInstancer.end();
+				return spriteInstancer.getDrawCount();
+			}
+		};
+
+		// Passe opaco: de frente para trs, sem blending, escrevendo profundidade
+		glEnable(GL_DEPTH_TEST);
+		glDepthMask(GL_TRUE);
+		glDisable(GL_BLEND);
+		setAlphaCutoff(0.5f);
+		beginScope("OPACOS");
+		endScope(drawCommands(0, firstTranslucent));
+
+		// O fundo vem depois dos opacos, ento os pixels cobertos por eles so descartados
+		// pelo teste de profundidade antes do fragment shader
+		glDepthMask(GL_FALSE);
+		beginScope("FUNDO");
+		background.draw(frame.camera);
+		endScope(1);
+
+		// Passe translcido: de trs para frente, com blending, testando mas sem escrever profundidade
+		glEnable(GL_BLEND);
+		setAlphaCutoff(0.0f);
+		beginScope("TRANSLUCIDOS");
+		endScope(drawCommands(firstTranslucent, (int)commands.size()));
+		glDepthMask(GL_TRUE);
+		glDisable(GL_DEPTH_TEST);
+
+		// O painel fica fora dos escopos medidos
+		if (overlay)
+			overlay->draw(width, height);
+	};
+
+	// A thread de renderizao fica com o contexto e desenha o frame N enquanto esta
+	// thread (eventos e simulao) prepara o N+1. O snapshot  solto antes do swap,
+	// ento a simulao no espera a apresentao do frame
+	FrameExchange frameExchange;
+	// O tempo de frame  medido entre um swap e o prximo, na thread que apresenta
+	std::chrono::steady_clock::time_point lastPresent;
+	bool presented = false;
+	auto lastGLStats = std::chrono::steady_clock::now();
+	auto presentFrame = [&]() {
+		framePacer.present();
+		auto now = std::chrono::steady_clock::now();
+		if (presented)
+			frameStats.record(std::chrono::duration<double, std::milli>(now - lastPresent).count());
+		lastPresent = now;
+		presented = true;
+		// Os contadores so zerados a cada frame; a linha mostra o ltimo
+		if (glStats)
+		{
+			GLCallCounts counts = takeGLCallCounts();
+			if (now - lastGLStats >= std::chrono::seconds(1))
+			{
+				printGLCallCounts(std::cout, counts);
+				lastGLStats = now;
+			}
+		}
+	};
+	auto renderLoop = [&]() {
+		glfwMakeContextCurrent(window);
+		while (FrameSnapshot* frame = frameExchange.acquire())
+		{
+			renderFrame(*frame);
+			frameExchange.release();
+			presentFrame();
+		}
+		glfwMakeContextCurrent(nullptr);
+	};
+	std::thread renderThread;
+	if (!singleThread)
+	{
+		glfwMakeContextCurrent(nullptr);
+		renderThread = std::thread(renderLoop);
+	}
 
-	float lastTime = glfwGetTime();
+	// No modo headless o tempo avana 1/60 s por frame, para as imagens serem reproduzveis
+	int frameCount = 0;
+	double lastTime = headless ? 0.0 : framePacer.getTime();
+	double statsStart = lastTime;
+	double accumulator = 0.0;
+	auto benchStart = std::chrono::steady_clock::now();
 
 	while (!glfwWindowShouldClose(window))
 	{
-		float currentTime = glfwGetTime();
-		float deltaTime = currentTime - lastTime;
+		double currentTime = headless ? frameCount / 60.0 : framePacer.getTime();
+		double deltaTime = currentTime - lastTime;
 		lastTime = currentTime;
    
 		glfwPollEvents();
+		auto simulationStart = std::chrono::steady_clock::now();
+
+		accumulator += std::min(deltaTime, MAX_FRAME_TIME);
+		while (accumulator >= SIMULATION_STEP)
+		{
+			for (size_t i = 0; i < sprites.size(); i++) {
+				sprites[i]->savePreviousTranslate();
+				sprites[i]->update(SIMULATION_STEP);
+				if (sprites[i]->getVelocity() != glm::vec3(0.0f))
+					spatialHash.move((int)i);
+			}
+			accumulator -= SIMULATION_STEP;
+		}
+		// Frao do prximo passo que j passou: o desenho fica entre o passo anterior e o atual
+		float alpha = (float)(accumulator / SIMULATION_STEP);
+		if (worldSprites > 0)
+			camera.follow(glm::vec2(sprites[PLAYER]->getInterpolatedTranslate(alpha)));
+
+		spatialHash.query(camera.getViewBounds(), visibleSprites);
+		if (currentTime - statsStart >= 1.0)
+		{
+			std::cout << "Sprites visiveis: " << visibleSprites.size() << " | fora da vista: " << sprites.size() - visibleSprites.size() << std::endl;
+			statsStart = currentTime;
+		}
 
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
-
-		for (int i = 0; i < sprites.size(); i++) {
-			sprites[i]->update(deltaTime);
-			sprites[i]->Draw();
+		// Copia o estado que o desenho precisa para o snapshot livre
+		FrameSnapshot& frame = frameExchange.beginWrite();
+		frame.camera = camera;
+		frame.time = (float)currentTime;
+		frame.drawMode = drawMode;
+		frame.simulationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - simulationStart).count();
+		frame.sprites.clear();
+		for (Sprite* sprite : visibleSprites) {
+			frame.sprites.push_back(*sprite);
+			frame.sprites.back().setTranslate(sprite->getInterpolatedTranslate(alpha));
 		}
+		frameExchange.publish();
+
+		if (singleThread)
+		{
+			FrameSnapshot* current = frameExchange.acquire();
+			renderFrame(*current);
+			frameExchange.release();
+			presentFrame();
+		}
+		frameStats.collect();
 
-		glfwSwapBuffers(window);
+		frameCount++;
+		if (frameLimit > 0 && frameCount >= frameLimit)
+			glfwSetWindowShouldClose(window, GL_TRUE);
+		if (benchSeconds > 0.0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - benchStart).count() >= benchSeconds)
+			glfwSetWindowShouldClose(window, GL_TRUE);
+	}
+	// A thread de renderizao desenha o ltimo frame publicado e devolve o contexto
+	frameExchange.close();
+	if (renderThread.joinable())
+	{
+		renderThread.join();
+		glfwMakeContextCurrent(window);
+	}
+	frameStats.collect();
+	frameStats.printReport(std::cout);
+	framePacer.printReport(std::cout);
+	if (benchSeconds > 0.0)
+		frameStats.printJson(std::cout);
+	if (profiler)
+	{
+		profiler->deleteQueries();
+		overlay->deleteBuffers();
+		delete profiler;
+		delete overlay;
+	}
+	int exitCode = 0;
+	if (offscreen)
+	{
+		if (dumpPath)
+			offscreen->save(dumpPath);
+		if (goldenPath && !offscreen->matches(goldenPath, tolerance))
+			exitCode = 1;
+		offscreen->deleteBuffers();
+		delete offscreen;
 	}
 	// Pede pra OpenGL desalocar os buffers
-	for (int i = 0; i < sprites.size(); i++)
+	for (Sprite* sprite : sprites)
 	{
-		sprites[i]->deleteVertexArray();
+		sprite->deleteVertexArray();
 	}
+	spriteBatch.deleteBuffers();
+	spriteInstancer.deleteBuffers();
+	frameUniforms.deleteBuffer();
+	background.deleteBuffers();
+	atlas.deleteTextures();
+	textureArray.deleteTexture();
+	shader.deleteProgram();
+	batchShader.deleteProgram();
+	instancedShader.deleteProgram();
+	parallaxShader.deleteProgram();
+	overlayShader.deleteProgram();
 	// Finaliza a execuo da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
-	return 0;
+	return exitCode;
 }
 
 // Funo de callback de teclado - s pode ter uma instncia (deve ser esttica se
@@ -183,66 +551,79 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 {
 	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
 		glfwSetWindowShouldClose(window, GL_TRUE);
+	if (key == GLFW_KEY_1 && action == GLFW_PRESS)
+		drawMode = DRAW_PER_SPRITE;
+	if (key == GLFW_KEY_2 && action == GLFW_PRESS)
+		drawMode = DRAW_BATCHED;
+	if (key == GLFW_KEY_3 && action == GLFW_PRESS)
+		drawMode = DRAW_INSTANCED;
+	if (key == GLFW_KEY_F && action == GLFW_PRESS)
+		frameStats.printReport(std::cout);
 	if (key == GLFW_KEY_W && action == GLFW_PRESS)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(0, 1, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(0, 1, 0));
 	if (key == GLFW_KEY_S && action == GLFW_PRESS)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(0, -1, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(0, -1, 0));
 	if (key == GLFW_KEY_D && action == GLFW_PRESS)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(1, 0, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(1, 0, 0));
 	if (key == GLFW_KEY_A && action == GLFW_PRESS)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(-1, 0, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(-1, 0, 0));
 
 	if (key == GLFW_KEY_W && action == GLFW_RELEASE)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(0, -1, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(0, -1, 0));
 	if (key == GLFW_KEY_S && action == GLFW_RELEASE)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(0, 1, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(0, 1, 0));
 	if (key == GLFW_KEY_D && action == GLFW_RELEASE)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(-1, 0, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(-1, 0, 0));
 	if (key == GLFW_KEY_A && action == GLFW_RELEASE)
-		sprites[6]->setVelocity(sprites[6]->getVelocity() + glm::vec3(1, 0, 0));
+		sprites[PLAYER]->setVelocity(sprites[PLAYER]->getVelocity() + glm::vec3(1, 0, 0));
 }
 
-int setupShader()
+// Desenha o estado inicial da cena na CPU, sem criar janela nem contexto OpenGL
+int renderSoftware(const std::vector<SceneSprite>& scene, bool followPlayer, int threadCount, const char* dumpPath, const char* goldenPath, int tolerance)
 {
-	// Vertex shader
-	GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-	glCompileShader(vertexShader);
-	// Checando erros de compilao (exibio via log no terminal)
-	GLint success;
-	GLchar infoLog[512];
-	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-	}
-	// Fragment shader
-	GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-	glCompileShader(fragmentShader);
-	// Checando erros de compilao (exibio via log no terminal)
-	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-	if (!success)
-	{
-		glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-	}
-	// Linkando os shaders e criando o identificador do programa de shader
-	GLuint shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
-	// Checando por erros de linkagem
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-	if (!success) {
-		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-	}
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-
-	return shaderProgram;
+	SoftwareRenderer renderer(WIDTH, HEIGHT, threadCount);
+	int textures[IMAGE_COUNT];
+	for (int i = 0; i < IMAGE_COUNT; i++)
+	{
+		textures[i] = renderer.addTexture(images[i].path);
+	}
+	renderer.addBackgroundLayer(renderer.addTexture("assets/orig.png"), 1.0f, glm::vec2(WIDTH, HEIGHT));
+
+	Camera2D camera(WIDTH, HEIGHT);
+	if (followPlayer)
+	{
+		camera.setWorldBounds(glm::vec4(0.0f, 0.0f, WORLD_SIZE));
+		camera.follow(glm::vec2(scene[PLAYER].translate));
+	}
+
+	// Mesma ordem de pintura da RenderQueue: por camada e, dentro dela, na ordem da cena
+	std::vector<int> order(scene.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = (int)i;
+	std::stable_sort(order.begin(), order.end(), [&scene](int a, int b) { return scene[a].renderLayer < scene[b].renderLayer; });
+
+	auto start = std::chrono::steady_clock::now();
+	renderer.begin();
+	for (int i : order)
+	{
+		SoftwareSprite sprite;
+		sprite.texture = textures[scene[i].image];
+		sprite.translate = scene[i].translate;
+		sprite.scale = scene[i].scale;
+		sprite.sheetSize = glm::ivec2(images[scene[i].image].columns, images[scene[i].image].rows);
+		renderer.submit(sprite);
+	}
+	renderer.end(camera);
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Renderizacao em software: " << milliseconds << " ms com " << renderer.getThreadCount() << " threads" << std::endl;
+
+	std::vector<unsigned char> rgb;
+	renderer.readPixels(rgb);
+	if (dumpPath)
+		saveImagePPM(dumpPath, rgb, WIDTH, HEIGHT);
+	if (goldenPath && !matchesReference(rgb, WIDTH, HEIGHT, goldenPath, tolerance))
+		return 1;
+	return 0;
 }
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
@@ -0,0 +1,94 @@
+#include "TextureArray.h"
+#include "stb/stb_image.h"
+#include <algorithm>
+#include <iostream>
+
+int TextureArray::addImage(const char* path, int columns, int rows)
+{
+	Image image;
+	image.path = path;
+	image.columns = columns;
+	image.rows = rows;
+	int numChannels;
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* data = stbi_load(path, &image.width, &image.height, &numChannels, STBI_rgb_alpha);
+	if (data)
+	{
+		image.pixels.assign(data, data + image.width * image.height * 4);
+	}
+	else
+	{
+		std::cerr << "Erro ao carregar textura: " << path << std::endl;
+		image.width = 0;
+		image.height = 0;
+	}
+	stbi_image_free(data);
+	m_images.push_back(image);
+	m_regions.push_back(AtlasRegion());
+	return (int)m_images.size() - 1;
+}
+
+void TextureArray::build()
+{
+	int layerWidth = 1;
+	int layerHeight = 1;
+	for (const Image& image : m_images)
+	{
+		layerWidth = std::max(layerWidth, image.width);
+		layerHeight = std::max(layerHeight, image.height);
+	}
+	int layerCount = (int)m_images.size();
+
+	glGenTextures(1, &m_textureID);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, layerWidth, layerHeight, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+	std::vector<unsigned char> layer(layerWidth * layerHeight * 4);
+	for (int i = 0; i < layerCount; i++)
+	{
+		Image& image = m_images[i];
+		if (image.pixels.empty())
+		{
+			continue;
+		}
+		//a imagem fica no canto (0,0) e a borda dela e repetida ate o fim da camada
+		for (int y = 0; y < layerHeight; y++)
+		{
+			int sourceY = std::min(y, image.height - 1);
+			for (int x = 0; x < layerWidth; x++)
+			{
+				int sourceX = std::min(x, image.width - 1);
+				const unsigned char* source = &image.pixels[(sourceY * image.width + sourceX) * 4];
+				std::copy(source, source + 4, &layer[(y * layerWidth + x) * 4]);
+			}
+		}
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, layerWidth, layerHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE, layer.data());
+
+		AtlasRegion& region = m_regions[i];
+		region.textureID = m_textureID;
+		region.target = GL_TEXTURE_2D_ARRAY;
+		region.layer = i;
+		region.width = image.width;
+		region.height = image.height;
+		region.uvRect = glm::vec4(0.0f, 0.0f, (float)image.width / layerWidth, (float)image.height / layerHeight);
+		region.alphaMode = classifyAlpha(image.pixels.data(), image.width * image.height);
+		region.meshName = registerHullMesh(image.path, image.pixels.data(), image.width, image.height, image.columns, image.rows);
+		std::vector<unsigned char>().swap(image.pixels);
+	}
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+const AtlasRegion& TextureArray::getRegion(int regionID) const
+{
+	return m_regions[regionID];
+}
+
+void TextureArray::deleteTexture()
+{
+	glDeleteTextures(1, &m_textureID);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <string>
+#include <vector>
+#include "TextureAtlas.h"
+
+// Carrega as imagens como camadas de uma unica GL_TEXTURE_2D_ARRAY. Todas as
+// camadas tem o tamanho da maior imagem; as menores ficam no canto da camada,
+// com a borda repetida no resto, e o uvRect da regiao aponta so para elas.
+// Pensado para spritesheets do mesmo tamanho, onde cada camada usa o uvRect inteiro.
+class TextureArray
+{
+public:
+	int addImage(const char* path, int columns = 1, int rows = 1);
+	void build();
+	const AtlasRegion& getRegion(int regionID) const;
+	void deleteTexture();
+private:
+	struct Image
+	{
+		std::string path;
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels;
+		int columns = 1;
+		int rows = 1;
+	};
+	std::vector<Image> m_images;
+	std::vector<AtlasRegion> m_regions;
+	GLuint m_textureID = 0;
+};
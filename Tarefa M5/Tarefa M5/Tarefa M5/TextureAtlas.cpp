@@ -0,0 +1,262 @@
+#include "TextureAtlas.h"
+#include "stb/stb_image.h"
+#include "AlphaHull.h"
+#include "MeshRegistry.h"
+#include <algorithm>
+#include <iostream>
+
+AlphaMode classifyAlpha(const unsigned char* rgba, int pixelCount)
+{
+	AlphaMode mode = ALPHA_OPAQUE;
+	for (int i = 0; i < pixelCount; i++)
+	{
+		unsigned char alpha = rgba[i * 4 + 3];
+		if (alpha == 0)
+		{
+			mode = ALPHA_TESTED;
+		}
+		else if (alpha != 255)
+		{
+			return ALPHA_TRANSLUCENT;
+		}
+	}
+	return mode;
+}
+
+std::string registerHullMesh(const std::string& path, const unsigned char* rgba, int width, int height, int columns, int rows)
+{
+	std::vector<glm::vec2> hull = computeAlphaHull(rgba, width, height, columns, rows);
+	if (hull.empty())
+	{
+		return "";
+	}
+	std::string name = path + "#hull";
+	MeshRegistry::registerPolygon(name, hull);
+	return name;
+}
+
+TextureAtlas::TextureAtlas(int pageSize, int padding, int gutter)
+{
+	m_pageSize = pageSize;
+	m_padding = padding;
+	m_gutter = gutter;
+}
+
+int TextureAtlas::addImage(const char* path, int columns, int rows)
+{
+	Image image;
+	image.path = path;
+	image.columns = columns;
+	image.rows = rows;
+	int numChannels;
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* data = stbi_load(path, &image.width, &image.height, &numChannels, STBI_rgb_alpha);
+	if (data)
+	{
+		image.pixels.assign(data, data + image.width * image.height * 4);
+	}
+	else
+	{
+		std::cerr << "Erro ao carregar textura: " << path << std::endl;
+		image.width = 0;
+		image.height = 0;
+	}
+	stbi_image_free(data);
+	m_images.push_back(image);
+	m_regions.push_back(AtlasRegion());
+	return (int)m_images.size() - 1;
+}
+
+void TextureAtlas::build()
+{
+	//as imagens mais altas entram primeiro, o que deixa o skyline mais plano
+	std::vector<int> order(m_images.size());
+	for (int i = 0; i < (int)order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [this](int a, int b) { return m_images[a].height > m_images[b].height; });
+
+	for (int index : order)
+	{
+		Image& image = m_images[index];
+		if (image.pixels.empty())
+		{
+			continue;
+		}
+		int slotWidth = image.width + 2 * m_gutter + m_padding;
+		int slotHeight = image.height + 2 * m_gutter + m_padding;
+		if (slotWidth > m_pageSize || slotHeight > m_pageSize)
+		{
+			std::cerr << "Imagem maior que a pagina do atlas: " << image.path << std::endl;
+			continue;
+		}
+		int x, y;
+		for (int page = 0; page <= (int)m_pages.size(); page++)
+		{
+			if (page == (int)m_pages.size())
+			{
+				newPage();
+			}
+			if (insert(m_pages[page], slotWidth, slotHeight, x, y))
+			{
+				image.page = page;
+				image.x = x + m_gutter;
+				image.y = y + m_gutter;
+				break;
+			}
+		}
+		blit(m_pages[image.page], image);
+	}
+
+	for (Page& page : m_pages)
+	{
+		glGenTextures(1, &page.textureID);
+		glBindTexture(GL_TEXTURE_2D, page.textureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_pageSize, m_pageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, page.pixels.data());
+		glGenerateMipmap(GL_TEXTURE_2D);
+		//depois do upload a copia na CPU nao e mais necessaria
+		std::vector<unsigned char>().swap(page.pixels);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	for (int i = 0; i < (int)m_images.size(); i++)
+	{
+		Image& image = m_images[i];
+		if (image.page < 0)
+		{
+			continue;
+		}
+		AtlasRegion& region = m_regions[i];
+		region.textureID = m_pages[image.page].textureID;
+		region.width = image.width;
+		region.height = image.height;
+		region.uvRect = glm::vec4(image.x, image.y, image.width, image.height) / (float)m_pageSize;
+		region.alphaMode = classifyAlpha(image.pixels.data(), image.width * image.height);
+		region.meshName = registerHullMesh(image.path, image.pixels.data(), image.width, image.height, image.columns, image.rows);
+		std::vector<unsigned char>().swap(image.pixels);
+	}
+}
+
+const AtlasRegion& TextureAtlas::getRegion(int regionID) const
+{
+	return m_regions[regionID];
+}
+
+int TextureAtlas::getPageCount() const
+{
+	return (int)m_pages.size();
+}
+
+void TextureAtlas::deleteTextures()
+{
+	for (Page& page : m_pages)
+	{
+		glDeleteTextures(1, &page.textureID);
+	}
+}
+
+// Procura o no do skyline onde o retangulo fica mais baixo; em caso de empate,
+// o que estiver mais a esquerda
+bool TextureAtlas::insert(Page& page, int width, int height, int& outX, int& outY)
+{
+	int bestIndex = -1;
+	int bestTop = m_pageSize + 1;
+	for (int i = 0; i < (int)page.skyline.size(); i++)
+	{
+		int y = fitHeight(page, i, width, height);
+		if (y >= 0 && y + height < bestTop)
+		{
+			bestIndex = i;
+			bestTop = y + height;
+			outX = page.skyline[i].x;
+			outY = y;
+		}
+	}
+	if (bestIndex < 0)
+	{
+		return false;
+	}
+
+	page.skyline.insert(page.skyline.begin() + bestIndex, { outX, outY + height, width });
+	//os nos cobertos pelo novo retangulo encolhem ou somem
+	for (int i = bestIndex + 1; i < (int)page.skyline.size(); i++)
+	{
+		const SkylineNode& previous = page.skyline[i - 1];
+		SkylineNode& node = page.skyline[i];
+		int overlap = previous.x + previous.width - node.x;
+		if (overlap <= 0)
+		{
+			break;
+		}
+		node.x += overlap;
+		node.width -= overlap;
+		if (node.width > 0)
+		{
+			break;
+		}
+		page.skyline.erase(page.skyline.begin() + i);
+		i--;
+	}
+	//junta nos vizinhos na mesma altura
+	for (int i = 0; i + 1 < (int)page.skyline.size(); i++)
+	{
+		if (page.skyline[i].y == page.skyline[i + 1].y)
+		{
+			page.skyline[i].width += page.skyline[i + 1].width;
+			page.skyline.erase(page.skyline.begin() + i + 1);
+			i--;
+		}
+	}
+	return true;
+}
+
+// Altura em que o retangulo encaixa comecando no no indicado, ou -1 se nao cabe
+int TextureAtlas::fitHeight(const Page& page, int nodeIndex, int width, int height) const
+{
+	int x = page.skyline[nodeIndex].x;
+	if (x + width > m_pageSize)
+	{
+		return -1;
+	}
+	int y = 0;
+	int widthLeft = width;
+	for (int i = nodeIndex; widthLeft > 0; i++)
+	{
+		y = std::max(y, page.skyline[i].y);
+		if (y + height > m_pageSize)
+		{
+			return -1;
+		}
+		widthLeft -= page.skyline[i].width;
+	}
+	return y;
+}
+
+void TextureAtlas::newPage()
+{
+	Page page;
+	page.skyline.push_back({ 0, 0, m_pageSize });
+	page.pixels.assign(m_pageSize * m_pageSize * 4, 0);
+	m_pages.push_back(page);
+}
+
+// Copia a imagem para a pagina repetindo os pixels da borda na area do gutter
+void TextureAtlas::blit(Page& page, const Image& image)
+{
+	for (int dy = -m_gutter; dy < image.height + m_gutter; dy++)
+	{
+		int sourceY = std::min(std::max(dy, 0), image.height - 1);
+		for (int dx = -m_gutter; dx < image.width + m_gutter; dx++)
+		{
+			int sourceX = std::min(std::max(dx, 0), image.width - 1);
+			const unsigned char* source = &image.pixels[(sourceY * image.width + sourceX) * 4];
+			unsigned char* destination = &page.pixels[((image.y + dy) * m_pageSize + image.x + dx) * 4];
+			std::copy(source, source + 4, destination);
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <glad/glad.h>
+#include "dependencies/glm/glm.hpp"
+#include <string>
+#include <vector>
+
+// Classificacao da transparencia de uma imagem, feita quando ela e carregada:
+// opaca (alfa sempre 255), recortada (alfa so 0 ou 255, desenhada com discard)
+// ou translucida (tem alfa intermediario e precisa de blending).
+enum AlphaMode { ALPHA_OPAQUE, ALPHA_TESTED, ALPHA_TRANSLUCENT };
+AlphaMode classifyAlpha(const unsigned char* rgba, int pixelCount);
+
+// Registra no MeshRegistry o poligono justo da imagem (ver computeAlphaHull) e devolve
+// o nome da malha, ou vazio quando o quad unitario ja serve
+std::string registerHullMesh(const std::string& path, const unsigned char* rgba, int width, int height, int columns, int rows);
+
+// Sub-retangulo de uma pagina do atlas. uvRect guarda o deslocamento (xy) e o
+// tamanho (zw) da regiao em coordenadas de textura da pagina. Regioes de uma
+// TextureArray usam target GL_TEXTURE_2D_ARRAY e indicam a camada. meshName e a
+// malha recortada pelo alfa que os sprites da regiao usam no lugar do quad.
+struct AtlasRegion
+{
+	GLuint textureID = 0;
+	GLenum target = GL_TEXTURE_2D;
+	int layer = 0;
+	AlphaMode alphaMode = ALPHA_TRANSLUCENT;
+	glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	int width = 0;
+	int height = 0;
+	std::string meshName;
+};
+
+// Junta varias imagens em uma ou mais texturas grandes, empacotadas com o
+// algoritmo skyline (bottom-left). Cada imagem ganha uma borda (gutter) com os
+// pixels da beirada repetidos, para o filtro linear nao puxar a imagem vizinha,
+// e um espaco vazio (padding) entre as regioes.
+class TextureAtlas
+{
+public:
+	TextureAtlas(int pageSize = 2048, int padding = 2, int gutter = 4);
+	int addImage(const char* path, int columns = 1, int rows = 1);
+	void build();
+	const AtlasRegion& getRegion(int regionID) const;
+	int getPageCount() const;
+	void deleteTextures();
+private:
+	struct Image
+	{
+		std::string path;
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels;
+		int columns = 1;
+		int rows = 1;
+		int page = -1;
+		int x = 0;
+		int y = 0;
+	};
+	struct SkylineNode
+	{
+		int x;
+		int y;
+		int width;
+	};
+	struct Page
+	{
+		std::vector<SkylineNode> skyline;
+		std::vector<unsigned char> pixels;
+		GLuint textureID = 0;
+	};
+	bool insert(Page& page, int width, int height, int& outX, int& outY);
+	int fitHeight(const Page& page, int nodeIndex, int width, int height) const;
+	void newPage();
+	void blit(Page& page, const Image& image);
+	int m_pageSize;
+	int m_padding;
+	int m_gutter;
+	std::vector<Image> m_images;
+	std::vector<Page> m_pages;
+	std::vector<AtlasRegion> m_regions;
+};